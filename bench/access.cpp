@@ -0,0 +1,50 @@
+// Element access cost with and without checks. "two" fills data/two's
+// 2^20 element vector and walks it by index and by iterator; "five"
+// replays data/five's clear-and-refill cycles, each followed by an
+// iterator walk like its print loop. Built twice: bench_access keeps the
+// checks, bench_access_unchecked defines SJTU_VECTOR_UNCHECKED.
+#include "bench.hpp"
+#include "vector.hpp"
+
+int main() {
+    long long sum = 0;
+    sjtu::vector<long long> v;
+    for (long long i = 0; i < 1LL << 20; ++i) v.push_back(i);
+
+    bench::report("two: operator[] sum x50", bench::time_ms([&] {
+                      for (int r = 0; r < 50; ++r) {
+                          for (size_t i = 0; i < v.size(); ++i) sum += v[i];
+                      }
+                  }));
+    bench::report("two: operator[] prefix sums x50", bench::time_ms([&] {
+                      for (int r = 0; r < 50; ++r) {
+                          for (size_t i = 1; i < v.size(); ++i) v[i] += v[i - 1] & 1;
+                      }
+                  }));
+    bench::report("two: iterator sum x50", bench::time_ms([&] {
+                      for (int r = 0; r < 50; ++r) {
+                          for (sjtu::vector<long long>::iterator it = v.begin(); it != v.end();
+                               ++it) {
+                              sum += *it;
+                          }
+                      }
+                  }));
+    bench::report("five: refill and walk x20000", bench::time_ms([&] {
+                      sjtu::vector<int> small, large;
+                      long long s = 0;
+                      for (int r = 0; r < 20000; ++r) {
+                          small.clear();
+                          for (int i = 1; i <= 10; ++i) small.push_back(i);
+                          large.clear();
+                          for (int i = 0; i < 1000; ++i) large.push_back(i);
+                          for (sjtu::vector<int>::iterator it = small.begin(); it != small.end();
+                               ++it) {
+                              s += *it;
+                          }
+                          for (size_t i = 0; i < large.size(); ++i) s += large[i];
+                      }
+                      sum += s;
+                  }));
+    bench::keep(sum);
+    return 0;
+}
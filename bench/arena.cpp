@@ -0,0 +1,76 @@
+// Default heap against a per-request arena, reset after every request.
+// "two" replays data/two's shape (a 2^20 element vector with a block of
+// front inserts and erases); "five" replays data/five's many short-lived
+// small and medium vectors.
+#include "arena.hpp"
+#include "bench.hpp"
+#include "vector.hpp"
+
+template <typename Vector, typename Make>
+long long pattern_two(Make make) {
+    Vector v = make();
+    for (long long i = 0; i < 1LL << 20; ++i) v.push_back(i);
+    v.insert(v.begin(), 2048, -1);
+    v.erase(v.begin(), v.begin() + 1024);
+    return v.back() + v.front();
+}
+
+template <typename Vector, typename Make>
+long long pattern_five(Make make) {
+    long long sum = 0;
+    for (int k = 0; k < 200; ++k) {
+        Vector small = make();
+        for (int i = 1; i <= 10; ++i) small.push_back(i);
+        small.clear();
+        for (int i = 20; i <= 25; ++i) small.push_back(i);
+        Vector medium = make();
+        for (int i = 0; i < 1000; ++i) medium.push_back(i);
+        medium.clear();
+        medium.push_back(42);
+        sum += small[0] + medium[0];
+    }
+    return sum;
+}
+
+int main() {
+    using heap_ll = sjtu::vector<long long>;
+    using arena_ll = sjtu::vector<long long, sjtu::arena_allocator<long long>>;
+    using heap_int = sjtu::vector<int>;
+    using arena_int = sjtu::vector<int, sjtu::arena_allocator<int>>;
+    long long sum = 0;
+    sjtu::arena a;
+
+    const int kTwo = 50;
+    bench::report("two: heap, 50 requests", bench::time_ms([&] {
+                      for (int r = 0; r < kTwo; ++r) {
+                          sum += pattern_two<heap_ll>([] { return heap_ll(); });
+                      }
+                  }));
+    bench::report("two: arena, 50 requests", bench::time_ms([&] {
+                      for (int r = 0; r < kTwo; ++r) {
+                          sum += pattern_two<arena_ll>([&] {
+                              return arena_ll(sjtu::arena_allocator<long long>(a));
+                          });
+                          a.reset();
+                      }
+                  }));
+
+    const int kFive = 2000;
+    bench::report("five: heap, 2000 requests", bench::time_ms([&] {
+                      for (int r = 0; r < kFive; ++r) {
+                          sum += pattern_five<heap_int>([] { return heap_int(); });
+                      }
+                  }));
+    bench::report("five: arena, 2000 requests", bench::time_ms([&] {
+                      for (int r = 0; r < kFive; ++r) {
+                          sum += pattern_five<arena_int>([&] {
+                              return arena_int(sjtu::arena_allocator<int>(a));
+                          });
+                          a.reset();
+                      }
+                  }));
+    std::printf("arena blocks after the run: %zu (%zu KiB)\n", a.block_count(),
+                a.bytes_reserved() / 1024);
+    bench::keep(sum);
+    return 0;
+}
@@ -0,0 +1,29 @@
+// Copy assignment into a vector that already has room, the shape of
+// data/seven's `c = a` and data/one's `vv = v`, repeated many times.
+#include "bench.hpp"
+#include "vector.hpp"
+
+#include <string>
+
+template <typename T, typename Make>
+double run(size_t n, int reps, Make make) {
+    sjtu::vector<T> source;
+    for (size_t i = 0; i < n; ++i) source.push_back(make(i));
+    sjtu::vector<T> target(source);
+    return bench::time_ms([&] {
+        for (int r = 0; r < reps; ++r) {
+            target = source;
+            bench::keep(target);
+        }
+    });
+}
+
+int main() {
+    bench::report("int, 16 elements x2^20", run<int>(16, 1 << 20, [](size_t i) { return int(i); }));
+    bench::report("int, 4096 elements x2^14",
+                  run<int>(4096, 1 << 14, [](size_t i) { return int(i); }));
+    bench::report("string, 16 elements x2^18", run<std::string>(16, 1 << 18, [](size_t i) {
+                      return std::string(24, char('a' + i % 26));
+                  }));
+    return 0;
+}
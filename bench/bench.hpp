@@ -0,0 +1,30 @@
+#ifndef SJTU_BENCH_HPP
+#define SJTU_BENCH_HPP
+
+#include <chrono>
+#include <cstdio>
+
+namespace bench {
+
+// Runs fn once and returns the wall time in milliseconds.
+template <typename Fn>
+double time_ms(Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+inline void report(const char *name, double ms) {
+    std::printf("%-44s %10.2f ms\n", name, ms);
+}
+
+// Keeps the optimizer from discarding a computed value.
+template <typename T>
+inline void keep(const T &value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+}  // namespace bench
+
+#endif
@@ -0,0 +1,60 @@
+// Appending from 1, 2, 4, ... threads up to the core count: a
+// concurrent_vector against a sjtu::vector behind a mutex. Each thread
+// does some work per element so the shared counter is not the whole story.
+#include "bench.hpp"
+#include "concurrent_vector.hpp"
+#include "vector.hpp"
+
+#include <mutex>
+#include <thread>
+
+static const int kTotal = 1 << 22;
+
+static long long work(long long x) {
+    for (int i = 0; i < 16; ++i) {
+        x = x * 6364136223846793005LL + 1442695040888963407LL;
+    }
+    return x;
+}
+
+template <typename Append>
+double run(int threads, Append append) {
+    return bench::time_ms([&] {
+        sjtu::vector<std::thread> pool;
+        for (int t = 0; t < threads; ++t) {
+            pool.emplace_back([&append, t, threads] {
+                for (int i = t; i < kTotal; i += threads) append(work(i));
+            });
+        }
+        for (auto &th : pool) th.join();
+    });
+}
+
+int main() {
+    int cores = (int)std::thread::hardware_concurrency();
+    if (cores < 1) cores = 1;
+    std::printf("%d appends, %d cores\n", kTotal, cores);
+    for (int threads = 1;; threads *= 2) {
+        if (threads > cores) threads = cores;
+        char name[64];
+
+        sjtu::concurrent_vector<long long> cv;
+        double lock_free = run(threads, [&](long long x) { cv.push_back(x); });
+        bench::keep(cv[cv.size() - 1]);
+        std::snprintf(name, sizeof name, "concurrent_vector, %d threads", threads);
+        bench::report(name, lock_free);
+
+        sjtu::vector<long long> v;
+        std::mutex m;
+        double locked = run(threads, [&](long long x) {
+            std::lock_guard<std::mutex> guard(m);
+            v.push_back(x);
+        });
+        bench::keep(v[v.size() - 1]);
+        std::snprintf(name, sizeof name, "vector + mutex, %d threads", threads);
+        bench::report(name, locked);
+
+        if (threads == cores) break;
+    }
+    return 0;
+}
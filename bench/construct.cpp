@@ -0,0 +1,55 @@
+// Building data/two's 2^20 long longs: a push_back loop against the bulk
+// constructors, plus copy construction. Each build is repeated 100 times.
+#include "bench.hpp"
+#include "vector.hpp"
+
+#include <string>
+
+int main() {
+    const long long kSize = 1LL << 20;
+    const int kReps = 100;
+    long long sum = 0;
+    sjtu::vector<long long> source;
+    for (long long i = 0; i < kSize; ++i) source.push_back(i);
+    const long long *first = &source[0];
+
+    bench::report("push_back loop", bench::time_ms([&] {
+                      for (int r = 0; r < kReps; ++r) {
+                          sjtu::vector<long long> v;
+                          for (long long i = 0; i < kSize; ++i) v.push_back(r);
+                          sum += v.back();
+                      }
+                  }));
+    bench::report("vector(n, 0)", bench::time_ms([&] {
+                      for (int r = 0; r < kReps; ++r) {
+                          sjtu::vector<long long> v(kSize, 0);
+                          sum += v.back();
+                      }
+                  }));
+    bench::report("vector(n, r)", bench::time_ms([&] {
+                      for (int r = 0; r < kReps; ++r) {
+                          sjtu::vector<long long> v(kSize, r);
+                          sum += v.back();
+                      }
+                  }));
+    bench::report("vector(first, last) from pointers", bench::time_ms([&] {
+                      for (int r = 0; r < kReps; ++r) {
+                          sjtu::vector<long long> v(first, first + kSize);
+                          sum += v.back();
+                      }
+                  }));
+    bench::report("vector(const vector &)", bench::time_ms([&] {
+                      for (int r = 0; r < kReps; ++r) {
+                          sjtu::vector<long long> v(source);
+                          sum += v.back();
+                      }
+                  }));
+    bench::report("vector<string>(2^16, s)", bench::time_ms([&] {
+                      for (int r = 0; r < kReps; ++r) {
+                          sjtu::vector<std::string> v(1 << 16, "payload");
+                          sum += v.back().size();
+                      }
+                  }));
+    bench::keep(sum);
+    return 0;
+}
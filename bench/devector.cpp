@@ -0,0 +1,55 @@
+// Front-heavy traffic on vector against devector: data/two's front
+// inserts and erases, and a FIFO that pushes at the back and pops at the
+// front.
+#include "bench.hpp"
+#include "devector.hpp"
+#include "vector.hpp"
+
+static const long long kBase = 1LL << 20;
+
+int main() {
+    sjtu::vector<long long> v;
+    sjtu::devector<long long> d;
+    for (long long i = 0; i < kBase; ++i) {
+        v.push_back(i);
+        d.push_back(i);
+    }
+    bench::report("vector: insert(begin) x2048", bench::time_ms([&] {
+                      for (long long i = 0; i < 2048; ++i) v.insert(v.begin(), i);
+                  }));
+    bench::report("devector: push_front x2048", bench::time_ms([&] {
+                      for (long long i = 0; i < 2048; ++i) d.push_front(i);
+                  }));
+    bench::report("vector: erase(begin) x1024", bench::time_ms([&] {
+                      for (int i = 0; i < 1024; ++i) v.erase(v.begin());
+                  }));
+    bench::report("devector: pop_front x1024", bench::time_ms([&] {
+                      for (int i = 0; i < 1024; ++i) d.pop_front();
+                  }));
+    bench::keep(v[0] + d[0]);
+
+    const long long kQueue = 1LL << 16, kOps = 1LL << 14;
+    long long sum = 0;
+    sjtu::vector<long long> vq;
+    sjtu::devector<long long> dq;
+    for (long long i = 0; i < kQueue; ++i) {
+        vq.push_back(i);
+        dq.push_back(i);
+    }
+    bench::report("vector: FIFO of 2^16, 2^14 ops", bench::time_ms([&] {
+                      for (long long i = 0; i < kOps; ++i) {
+                          vq.push_back(i);
+                          sum += vq.front();
+                          vq.erase(vq.begin());
+                      }
+                  }));
+    bench::report("devector: FIFO of 2^16, 2^14 ops", bench::time_ms([&] {
+                      for (long long i = 0; i < kOps; ++i) {
+                          dq.push_back(i);
+                          sum += dq.front();
+                          dq.pop_front();
+                      }
+                  }));
+    bench::keep(sum);
+    return 0;
+}
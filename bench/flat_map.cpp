@@ -0,0 +1,59 @@
+// Lookup tables of int -> int: flat_map against std::map for random
+// lookups, and building one by per-element insert against insert_range.
+#include "bench.hpp"
+#include "flat_map.hpp"
+#include "vector.hpp"
+
+#include <map>
+#include <random>
+
+static const size_t kLookups = size_t(1) << 23;
+
+static void run(size_t n) {
+    std::mt19937 rng(12345);
+    sjtu::vector<int> keys(n);
+    for (size_t i = 0; i < n; ++i) keys[i] = int(rng() >> 1);
+    sjtu::vector<int> probes(kLookups);
+    for (size_t i = 0; i < kLookups; ++i) {
+        probes[i] = i % 2 ? keys[rng() % n] : int(rng() >> 1);
+    }
+
+    std::map<int, int> tree;
+    for (size_t i = 0; i < n; ++i) tree.emplace(keys[i], int(i));
+    sjtu::flat_map<int, int> flat(keys, sjtu::vector<int>(keys));
+
+    long long hits = 0;
+    std::printf("%zu keys\n", n);
+    bench::report("  std::map find", bench::time_ms([&] {
+        for (size_t i = 0; i < kLookups; ++i) hits += tree.count(probes[i]);
+    }));
+    bench::report("  flat_map find", bench::time_ms([&] {
+        for (size_t i = 0; i < kLookups; ++i) hits += flat.contains(probes[i]);
+    }));
+
+    if (n <= (size_t(1) << 16)) {
+        bench::report("  flat_map insert one by one", bench::time_ms([&] {
+            sjtu::flat_map<int, int> m;
+            for (size_t i = 0; i < n; ++i) m.insert(keys[i], int(i));
+            hits += m.size();
+        }));
+    }
+    bench::report("  flat_map insert_range, 8 batches", bench::time_ms([&] {
+        sjtu::flat_map<int, int> m;
+        sjtu::vector<std::pair<int, int>> batch;
+        for (size_t b = 0; b < 8; ++b) {
+            batch.clear();
+            for (size_t i = b * n / 8; i < (b + 1) * n / 8; ++i) batch.push_back({keys[i], int(i)});
+            m.insert_range(batch.begin(), batch.end());
+        }
+        hits += m.size();
+    }));
+    bench::keep(hits);
+}
+
+int main() {
+    for (size_t n : {size_t(1) << 6, size_t(1) << 10, size_t(1) << 16, size_t(1) << 20}) {
+        run(n);
+    }
+    return 0;
+}
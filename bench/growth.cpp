@@ -0,0 +1,62 @@
+// Growth policies on data/six's pattern: fill past 10^6 elements up to the
+// next expansion, then pop 16 / push 16 right at that boundary.
+#include "bench.hpp"
+#include "vector.hpp"
+
+#include <string>
+
+// Shrinks as soon as half the buffer is free: the thrashing case that
+// hysteresis exists to avoid.
+struct eager_shrink : sjtu::growth::doubling {
+    static size_t shrink(size_t size, size_t cap) {
+        return size <= cap / 2 ? cap / 2 : cap;
+    }
+};
+
+template <typename T, typename Growth>
+void run(const char *name, int rounds) {
+    sjtu::vector<T, sjtu::allocator<T>, Growth> v;
+    for (int i = 0; i < 1000000; ++i) v.push_back(T());
+    size_t cap = v.capacity();
+    while (v.capacity() == cap) v.push_back(T());
+    cap = v.capacity();
+
+    long long reallocs = 0;
+    auto count = [&] {
+        if (v.capacity() != cap) {
+            ++reallocs;
+            cap = v.capacity();
+        }
+    };
+    double ms = bench::time_ms([&] {
+        for (int round = 0; round < rounds; ++round) {
+            for (int i = 0; i < 16; ++i) {
+                v.pop_back();
+                count();
+            }
+            for (int i = 0; i < 16; ++i) {
+                v.push_back(T());
+                count();
+            }
+        }
+    });
+    std::printf("%-28s cap %8zu  reallocs %7lld  %9.2f ms / %d rounds\n", name,
+                v.capacity(), reallocs, ms, rounds);
+}
+
+template <typename T>
+void run_all(const char *type, int rounds, int eager_rounds) {
+    std::printf("%s:\n", type);
+    run<T, sjtu::growth::doubling>("  doubling", rounds);
+    run<T, sjtu::growth::one_and_half>("  one_and_half", rounds);
+    run<T, sjtu::growth::fibonacci>("  fibonacci", rounds);
+    run<T, sjtu::growth::page_granular<>>("  page_granular", rounds);
+    run<T, eager_shrink>("  eager_shrink", eager_rounds);
+    run<T, sjtu::growth::shrink_with_hysteresis<>>("  shrink_with_hysteresis", rounds);
+}
+
+int main() {
+    run_all<long long>("long long", 100000, 10000);
+    run_all<std::string>("std::string", 100000, 100);
+    return 0;
+}
@@ -0,0 +1,61 @@
+// A 512 MiB sjtu::vector<long long> on the heap, on page_allocator and on
+// huge_page_allocator: filling it by push_back, which is mostly page
+// faults and regrowth, then 16M reads at random indices, which are mostly
+// TLB misses. The populated variant reserves first and takes its faults
+// in reserve, which is timed with the fill. The huge page figure is
+// AnonHugePages from /proc/self/smaps_rollup while the vector is alive.
+#include "bench.hpp"
+#include "page_allocator.hpp"
+#include "vector.hpp"
+
+#include <cstring>
+
+static const size_t kCount = size_t(1) << 26;
+static const size_t kReads = size_t(1) << 24;
+
+static long huge_page_kib() {
+    FILE *f = std::fopen("/proc/self/smaps_rollup", "r");
+    if (f == nullptr) return -1;
+    char line[256];
+    long kib = -1;
+    while (std::fgets(line, sizeof line, f)) {
+        if (std::strncmp(line, "AnonHugePages:", 14) == 0) kib = std::atol(line + 14);
+    }
+    std::fclose(f);
+    return kib;
+}
+
+template <typename Alloc>
+void run(const char *name, bool reserve_first) {
+    char label[96];
+    sjtu::vector<long long, Alloc> v;
+    double fill = bench::time_ms([&] {
+        if (reserve_first) v.reserve(kCount);
+        for (size_t i = 0; i < kCount; ++i) v.push_back((long long)i);
+    });
+    std::snprintf(label, sizeof label, "%s fill", name);
+    bench::report(label, fill);
+
+    long long sum = 0;
+    double gather = bench::time_ms([&] {
+        unsigned long long x = 88172645463325252ull;
+        for (size_t i = 0; i < kReads; ++i) {
+            x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+            sum += v[x & (kCount - 1)];
+        }
+    });
+    bench::keep(sum);
+    std::snprintf(label, sizeof label, "%s random reads", name);
+    bench::report(label, gather);
+    std::printf("%-44s %10ld KiB in huge pages\n", "", huge_page_kib());
+}
+
+int main() {
+    run<sjtu::allocator<long long>>("sjtu::allocator", false);
+    run<sjtu::page_allocator<long long>>("page_allocator", false);
+    run<sjtu::huge_page_allocator<long long>>("huge_page_allocator", false);
+    using populated = sjtu::huge_page_allocator<long long,
+                                                sjtu::detail::pages::huge_page_size, true>;
+    run<populated>("huge_page_allocator, populated", true);
+    return 0;
+}
@@ -0,0 +1,64 @@
+// Bulk insert and erase against the single-element loops, on data/two's
+// pattern: 2048 front inserts and 1024 front erases on 2^20 elements.
+#include "bench.hpp"
+#include "vector.hpp"
+
+#include <string>
+
+static const long long kBase = 1LL << 20;
+static const long long kFront = 1LL << 11;
+
+static sjtu::vector<long long> make_base() {
+    sjtu::vector<long long> v;
+    v.reserve(kBase + kFront);
+    for (long long i = 0; i < kBase; ++i) v.push_back(i);
+    return v;
+}
+
+int main() {
+    sjtu::vector<long long> src;
+    for (long long i = 0; i < kFront; ++i) src.push_back(i);
+
+    sjtu::vector<long long> a = make_base();
+    bench::report("long long: insert(begin, x) x2048", bench::time_ms([&] {
+                      for (long long i = 0; i < kFront; ++i) a.insert(a.begin(), i);
+                  }));
+    sjtu::vector<long long> b = make_base();
+    bench::report("long long: insert(begin, first, last)", bench::time_ms([&] {
+                      b.insert(b.begin(), src.begin(), src.end());
+                  }));
+    sjtu::vector<long long> c = make_base();
+    bench::report("long long: insert(begin, 2048, x)", bench::time_ms([&] {
+                      c.insert(c.begin(), kFront, 7);
+                  }));
+    sjtu::vector<long long> d = make_base();
+    bench::report("long long: append(p, 2048)", bench::time_ms([&] {
+                      d.append(&src[0], kFront);
+                  }));
+    bench::keep(a[0] + b[0] + c[0] + d[0]);
+
+    bench::report("long long: erase(begin) x1024", bench::time_ms([&] {
+                      for (int i = 0; i < 1024; ++i) a.erase(a.begin());
+                  }));
+    bench::report("long long: erase(begin, begin + 1024)", bench::time_ms([&] {
+                      b.erase(b.begin(), b.begin() + 1024);
+                  }));
+    bench::keep(a[0] + b[0]);
+
+    const int kStrings = 1 << 16, kStrFront = 512;
+    sjtu::vector<std::string> words;
+    for (int i = 0; i < kStrFront; ++i) words.push_back(std::to_string(i));
+    sjtu::vector<std::string> s, t;
+    for (int i = 0; i < kStrings; ++i) {
+        s.push_back(std::to_string(i));
+        t.push_back(std::to_string(i));
+    }
+    bench::report("string: insert(begin, x) x512", bench::time_ms([&] {
+                      for (int i = 0; i < kStrFront; ++i) s.insert(s.begin(), words[i]);
+                  }));
+    bench::report("string: insert(begin, first, last)", bench::time_ms([&] {
+                      t.insert(t.begin(), words.begin(), words.end());
+                  }));
+    bench::keep(s[0].size() + t[0].size());
+    return 0;
+}
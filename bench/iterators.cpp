@@ -0,0 +1,53 @@
+// Iterator throughput against a raw pointer baseline. The scans run over
+// a cache-resident 2^16 ints so they measure the loop, not memory; sort
+// and lower_bound use 2^22. Built twice: bench_iterators keeps the
+// checked iterators, bench_iterators_unchecked defines
+// SJTU_VECTOR_UNCHECKED_ITERATORS.
+#include "bench.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+
+sjtu::vector<int> make(int n) {
+    sjtu::vector<int> v;
+    v.reserve(n);
+    for (int i = 0; i < n; ++i) v.push_back((i * 2654435761u) >> 8);
+    return v;
+}
+
+int main() {
+    const int kHot = 1 << 16, kReps = 2000;
+    sjtu::vector<int> hot = make(kHot);
+    sjtu::vector<int> out = make(kHot);
+    const int *raw = &hot[0];
+    long long sum = 0;
+
+    bench::report("pointer loop sum", bench::time_ms([&] {
+                      for (int r = 0; r < kReps; ++r) {
+                          long long s = 0;
+                          for (const int *p = raw, *e = raw + hot.size(); p != e; ++p) s += *p;
+                          sum += s;
+                      }
+                  }));
+    bench::report("range-for sum", bench::time_ms([&] {
+                      for (int r = 0; r < kReps; ++r) {
+                          long long s = 0;
+                          for (int x : hot) s += x;
+                          sum += s;
+                      }
+                  }));
+    bench::report("std::copy", bench::time_ms([&] {
+                      for (int r = 0; r < kReps; ++r) std::copy(hot.begin(), hot.end(), out.begin());
+                  }));
+
+    sjtu::vector<int> big = make(1 << 22);
+    bench::report("std::sort 2^22", bench::time_ms([&] { std::sort(big.begin(), big.end()); }));
+    bench::report("std::lower_bound x2^20", bench::time_ms([&] {
+                      for (int i = 0; i < 1 << 20; ++i) {
+                          sum += std::lower_bound(big.begin(), big.end(), i << 4) - big.begin();
+                      }
+                  }));
+    bench::keep(sum);
+    bench::keep(out[kHot - 1]);
+    return 0;
+}
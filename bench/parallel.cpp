@@ -0,0 +1,98 @@
+// for_each, transform and reduce on a large vector<long long> and on a
+// vector of small matrices, serially and on pools of 1, 2, 4, ... threads
+// up to the core count.
+#include "bench.hpp"
+#include "class-matrix.hpp"
+#include "parallel.hpp"
+#include "vector.hpp"
+
+#include <thread>
+
+using Diamond::Matrix;
+
+static const size_t kLongs = 1 << 24;
+static const size_t kMatrices = 1 << 12;
+static const size_t kDim = 12;
+
+static void report(const char *what, size_t threads, double ms) {
+    char name[64];
+    if (threads == 0) {
+        std::snprintf(name, sizeof name, "%s, serial loop", what);
+    } else {
+        std::snprintf(name, sizeof name, "%s, %zu threads", what, threads);
+    }
+    bench::report(name, ms);
+}
+
+static void bench_longs(size_t threads) {
+    sjtu::vector<long long> v(kLongs);
+    for (size_t i = 0; i < kLongs; ++i) v[i] = i;
+    long long sum = 0;
+    double touch, total;
+    if (threads == 0) {
+        touch = bench::time_ms([&] {
+            for (size_t i = 0; i < kLongs; ++i) v[i] = v[i] * 3 + 1;
+        });
+        total = bench::time_ms([&] {
+            for (size_t i = 0; i < kLongs; ++i) sum += v[i] % 1000;
+        });
+    } else {
+        sjtu::parallel::thread_pool pool(threads);
+        touch = bench::time_ms([&] {
+            sjtu::parallel::for_each(v, [](long long &x) { x = x * 3 + 1; }, pool);
+        });
+        total = bench::time_ms([&] {
+            sum = sjtu::parallel::transform_reduce(
+                v, 0LL, std::plus<>(), [](long long x) { return x % 1000; }, pool);
+        });
+    }
+    bench::keep(sum);
+    report("long long for_each", threads, touch);
+    report("long long transform_reduce", threads, total);
+}
+
+static void bench_matrices(size_t threads) {
+    sjtu::vector<Matrix<double>> m(kMatrices, Matrix<double>(kDim, kDim, 0.5));
+    sjtu::vector<Matrix<double>> sq(kMatrices);
+    Matrix<double> sum;
+    auto square = [](const Matrix<double> &a) { return a * a; };
+    auto add = [](const Matrix<double> &a, const Matrix<double> &b) { return a + b; };
+    double mul, total;
+    if (threads == 0) {
+        mul = bench::time_ms([&] {
+            for (size_t i = 0; i < kMatrices; ++i) sq[i] = square(m[i]);
+        });
+        total = bench::time_ms([&] {
+            sum = sq[0];
+            for (size_t i = 1; i < kMatrices; ++i) sum = add(sum, sq[i]);
+        });
+    } else {
+        sjtu::parallel::thread_pool pool(threads);
+        mul = bench::time_ms([&] { sjtu::parallel::transform(m, sq, square, pool); });
+        total = bench::time_ms([&] {
+            sum = sjtu::parallel::reduce(sq, Matrix<double>(kDim, kDim, 0.0), add, pool);
+        });
+    }
+    bench::keep(sum);
+    report("Matrix<double> transform (a * a)", threads, mul);
+    report("Matrix<double> reduce (+)", threads, total);
+}
+
+int main() {
+    size_t cores = std::thread::hardware_concurrency();
+    if (cores < 1) cores = 1;
+    std::printf("%zu cores\n", cores);
+    bench_longs(0);
+    for (size_t t = 1;; t *= 2) {
+        if (t > cores) t = cores;
+        bench_longs(t);
+        if (t == cores) break;
+    }
+    bench_matrices(0);
+    for (size_t t = 1;; t *= 2) {
+        if (t > cores) t = cores;
+        bench_matrices(t);
+        if (t == cores) break;
+    }
+    return 0;
+}
@@ -0,0 +1,50 @@
+// Peak resident memory of pushing 2^23 + 1 long longs, about the 8M that
+// data/six grows to, one element at a time. The last push doubles a full
+// buffer, the worst case for a copying regrowth: both buffers are wholly
+// resident at once. Each allocator runs in a child process of its own and
+// its peak is read from the child's rusage. std::allocator copies into a
+// second buffer; the default allocator reallocs; page_allocator remaps,
+// or copies in steps under SJTU_NO_MREMAP.
+#include "bench.hpp"
+#include "page_allocator.hpp"
+#include "vector.hpp"
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <memory>
+
+static const int kCount = (1 << 23) + 1;
+
+template <typename Alloc>
+void measure(const char *name) {
+    std::fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        double ms = bench::time_ms([] {
+            sjtu::vector<long long, Alloc> v;
+            for (int i = 0; i < kCount; ++i) v.push_back(i);
+            bench::keep(v[kCount - 1]);
+        });
+        bench::report(name, ms);
+        std::fflush(stdout);
+        std::_Exit(0);
+    }
+    int status;
+    struct rusage usage;
+    if (pid < 0 || wait4(pid, &status, 0, &usage) != pid) {
+        std::printf("%s: could not run\n", name);
+        return;
+    }
+    std::printf("%-44s %10.1f MiB peak\n", "", usage.ru_maxrss / 1024.0);
+}
+
+int main() {
+    std::printf("payload %.1f MiB\n", kCount * sizeof(long long) / 1048576.0);
+    measure<std::allocator<long long>>("std::allocator");
+    measure<sjtu::allocator<long long>>("sjtu::allocator (realloc)");
+    measure<sjtu::page_allocator<long long>>("page_allocator");
+    return 0;
+}
@@ -0,0 +1,48 @@
+// Setting up a 2^24 int buffer that is then filled by a "decoder": a
+// push_back loop, resize followed by overwriting, and resize_default_init
+// followed by overwriting, which skips the zero-fill pass.
+#include "bench.hpp"
+#include "vector.hpp"
+
+static void decode(int *out, size_t n, int seed) {
+    for (size_t i = 0; i < n; ++i) out[i] = static_cast<int>(i) ^ seed;
+}
+
+int main() {
+    const size_t kSize = 1 << 24;
+    const int kReps = 10;
+    long long sum = 0;
+
+    bench::report("push_back loop", bench::time_ms([&] {
+                      for (int r = 0; r < kReps; ++r) {
+                          sjtu::vector<int> v;
+                          for (size_t i = 0; i < kSize; ++i) v.push_back(static_cast<int>(i) ^ r);
+                          sum += v.back();
+                      }
+                  }));
+    bench::report("resize then decode", bench::time_ms([&] {
+                      for (int r = 0; r < kReps; ++r) {
+                          sjtu::vector<int> v;
+                          v.resize(kSize);
+                          decode(v.data(), kSize, r);
+                          sum += v.back();
+                      }
+                  }));
+    bench::report("resize_default_init then decode", bench::time_ms([&] {
+                      for (int r = 0; r < kReps; ++r) {
+                          sjtu::vector<int> v;
+                          v.resize_default_init(kSize);
+                          decode(v.data(), kSize, r);
+                          sum += v.back();
+                      }
+                  }));
+    bench::report("assign(n, value) into reused buffer", bench::time_ms([&] {
+                      sjtu::vector<int> v;
+                      for (int r = 0; r < kReps; ++r) {
+                          v.assign(kSize, r);
+                          sum += v.back();
+                      }
+                  }));
+    bench::keep(sum);
+    return 0;
+}
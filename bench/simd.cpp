@@ -0,0 +1,85 @@
+// sjtu::simd against plain operator[] loops on vector<long long> at sizes
+// from L1-resident up to 512 MiB, past the last-level cache of most
+// machines. Every row visits the same total number of elements, so the
+// times compare across sizes. Levels the CPU lacks are skipped.
+#include "bench.hpp"
+#include "simd.hpp"
+#include "vector.hpp"
+
+static const size_t kVisits = size_t(1) << 28;
+static const char *kLevelNames[] = {"scalar", "sse2", "avx2", "avx512"};
+
+template <typename Fn>
+void row(const char *op, const char *how, size_t n, Fn fn) {
+    size_t reps = kVisits / n;
+    double ms = bench::time_ms([&] {
+        for (size_t r = 0; r < reps; ++r) fn();
+    });
+    char name[64];
+    std::snprintf(name, sizeof name, "%-6s 2^%-2d %s", op, __builtin_ctzll(n), how);
+    bench::report(name, ms);
+}
+
+static void run(size_t n) {
+    sjtu::vector<long long> v(n);
+    for (size_t i = 0; i < n; ++i) v[i] = (i * 2654435761u) % 1000003;
+    long long sink = 0;
+
+    row("sum", "loop", n, [&] {
+        long long s = 0;
+        for (size_t i = 0; i < v.size(); ++i) s += v[i];
+        sink += s;
+    });
+    row("min", "loop", n, [&] {
+        size_t at = 0;
+        for (size_t i = 1; i < v.size(); ++i) {
+            if (v[i] < v[at]) at = i;
+        }
+        sink += at;
+    });
+    row("find", "loop", n, [&] {
+        size_t i = 0;
+        while (i < v.size() && v[i] != -1) ++i;
+        sink += i;
+    });
+    row("count", "loop", n, [&] {
+        size_t c = 0;
+        for (size_t i = 0; i < v.size(); ++i) c += v[i] == 7;
+        sink += c;
+    });
+    row("fill", "loop", n, [&] {
+        for (size_t i = 0; i < v.size(); ++i) v[i] = 3;
+        bench::keep(v[n / 2]);
+    });
+    row("iota", "loop", n, [&] {
+        for (size_t i = 0; i < v.size(); ++i) v[i] = 5 + i;
+        bench::keep(v[n / 2]);
+    });
+
+    for (int l = 0; l <= int(sjtu::simd::supported_level()); ++l) {
+        sjtu::simd::set_level(sjtu::simd::level(l));
+        const char *how = kLevelNames[l];
+        row("sum", how, n, [&] { sink += sjtu::simd::sum(v); });
+        row("min", how, n, [&] { sink += sjtu::simd::min_element(v); });
+        row("find", how, n, [&] { sink += sjtu::simd::find(v, -1LL); });
+        row("count", how, n, [&] { sink += sjtu::simd::count(v, 7LL); });
+        row("fill", how, n, [&] {
+            sjtu::simd::fill(v, 3LL);
+            bench::keep(v[n / 2]);
+        });
+        row("iota", how, n, [&] {
+            sjtu::simd::iota(v, 5LL);
+            bench::keep(v[n / 2]);
+        });
+    }
+    sjtu::simd::set_level(sjtu::simd::supported_level());
+    bench::keep(sink);
+}
+
+int main() {
+    std::printf("%zu element visits per row\n", kVisits);
+    for (size_t n : {size_t(1) << 10, size_t(1) << 16, size_t(1) << 20, size_t(1) << 26}) {
+        run(n);
+    }
+    return 0;
+}
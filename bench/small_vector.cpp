@@ -0,0 +1,60 @@
+// Rows of two ints, the shape of data/seven's inner vectors: a vector of
+// sjtu::vector against a vector of small_vector<int, 4>. Both draw from a
+// counting allocator so the allocation counts are exact.
+#include "bench.hpp"
+#include "small_vector.hpp"
+#include "vector.hpp"
+
+static size_t allocations = 0;
+
+template <typename T>
+struct counting_allocator {
+    using value_type = T;
+    counting_allocator() = default;
+    template <typename U>
+    counting_allocator(const counting_allocator<U> &) {}
+    T *allocate(size_t n) {
+        ++allocations;
+        return sjtu::allocator<T>().allocate(n);
+    }
+    void deallocate(T *p, size_t n) { sjtu::allocator<T>().deallocate(p, n); }
+    template <typename U>
+    bool operator==(const counting_allocator<U> &) const { return true; }
+    template <typename U>
+    bool operator!=(const counting_allocator<U> &) const { return false; }
+};
+
+template <typename Row>
+void run(const char *name, int rows, int width) {
+    allocations = 0;
+    long long sum = 0;
+    sjtu::vector<Row> table;
+    table.reserve(rows);
+    double build = bench::time_ms([&] {
+        for (int i = 0; i < rows; ++i) {
+            Row &row = table.emplace_back();
+            for (int j = 0; j < width; ++j) row.push_back(i + j);
+        }
+    });
+    size_t built = allocations;
+    double scan = bench::time_ms([&] {
+        for (int pass = 0; pass < 10; ++pass) {
+            for (size_t i = 0; i < table.size(); ++i) {
+                for (size_t j = 0; j < table[i].size(); ++j) sum += table[i][j];
+            }
+        }
+    });
+    bench::keep(sum);
+    std::printf("%s, width %d: %zu allocations\n", name, width, built);
+    bench::report("  build", build);
+    bench::report("  scan x10", scan);
+}
+
+int main() {
+    const int kRows = 1 << 20;
+    for (int width : {2, 4, 8}) {
+        run<sjtu::vector<int, counting_allocator<int>>>("vector", kRows, width);
+        run<sjtu::small_vector<int, 4, counting_allocator<int>>>("small_vector<4>", kRows, width);
+    }
+    return 0;
+}
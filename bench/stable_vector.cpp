@@ -0,0 +1,48 @@
+// Growing to 1926 Matrix<Bint> elements, each Bint owning an 8 KB buffer:
+// sjtu::vector relocates every element on each reallocation, while
+// stable_vector only adds chunks. Then an indexed scan over long longs
+// to show the price of the extra indirection in operator[].
+#include "bench.hpp"
+#include "class-bint.hpp"
+#include "class-matrix.hpp"
+#include "stable_vector.hpp"
+#include "vector.hpp"
+
+static const int kMatrices = 1926;
+static const int kScan = 1 << 24;
+
+using Heavy = Diamond::Matrix<Util::Bint>;
+
+template <typename V>
+double grow_heavy() {
+    return bench::time_ms([] {
+        V v;
+        for (int i = 1; i <= kMatrices; ++i) {
+            v.push_back(Heavy(i % 8 + 1, i % 17 + 1, Util::Bint(i * 817)));
+        }
+        bench::keep(v[v.size() - 1]);
+    });
+}
+
+template <typename V>
+void scan(const char *name) {
+    V v;
+    for (int i = 0; i < kScan; ++i) v.push_back(i);
+    long long sum = 0;
+    double ms = bench::time_ms([&] {
+        for (int rep = 0; rep < 4; ++rep) {
+            for (size_t i = 0; i < v.size(); ++i) sum += v[i];
+        }
+    });
+    bench::keep(sum);
+    bench::report(name, ms);
+}
+
+int main() {
+    bench::report("vector<Matrix<Bint>> push_back", grow_heavy<sjtu::vector<Heavy>>());
+    bench::report("stable_vector<Matrix<Bint>> push_back",
+                  grow_heavy<sjtu::stable_vector<Heavy>>());
+    scan<sjtu::vector<long long>>("vector<long long> indexed scan x4");
+    scan<sjtu::stable_vector<long long>>("stable_vector<long long> indexed scan x4");
+    return 0;
+}
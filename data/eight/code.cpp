@@ -0,0 +1,188 @@
+#include "vector.hpp"
+
+#include "class-integer.hpp"
+
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct Tracked {
+    static int copies;
+    static int moves;
+    int value;
+    explicit Tracked(int v) : value(v) {
+    }
+    Tracked(const Tracked &other) : value(other.value) {
+        ++copies;
+    }
+    Tracked(Tracked &&other) noexcept : value(other.value) {
+        other.value = -1;
+        ++moves;
+    }
+    Tracked &operator=(const Tracked &other) {
+        value = other.value;
+        ++copies;
+        return *this;
+    }
+    Tracked &operator=(Tracked &&other) noexcept {
+        value = other.value;
+        other.value = -1;
+        ++moves;
+        return *this;
+    }
+};
+int Tracked::copies = 0;
+int Tracked::moves = 0;
+
+struct MayThrow {
+    static int copies;
+    int value;
+    explicit MayThrow(int v) : value(v) {
+    }
+    MayThrow(const MayThrow &other) : value(other.value) {
+        ++copies;
+    }
+    MayThrow(MayThrow &&other) : value(other.value) {
+    }
+    MayThrow &operator=(const MayThrow &) = default;
+};
+int MayThrow::copies = 0;
+
+sjtu::vector<std::string> make_words(int n) {
+    sjtu::vector<std::string> v;
+    for (int i = 0; i < n; ++i) {
+        v.push_back(std::string(40, char('a' + i % 26)));
+    }
+    return v;
+}
+
+void TestMoveConstruct() {
+    std::cout << "Testing move constructor and assignment..." << std::endl;
+    sjtu::vector<std::vector<int>> a;
+    for (int i = 0; i < 5; ++i) {
+        a.push_back(std::vector<int>(i + 1, i));
+    }
+    const int *row = &a[4][0];
+    sjtu::vector<std::vector<int>> b(std::move(a));
+    std::cout << a.size() << " " << a.empty() << " " << b.size() << " "
+              << (&b[4][0] == row) << std::endl;
+    a = std::move(b);
+    std::cout << a.size() << " " << b.size() << " " << (&a[4][0] == row) << std::endl;
+    a = std::move(a);
+    std::cout << a.size() << " " << a[4].size() << std::endl;
+    b.push_back(std::vector<int>{7, 8});
+    std::cout << b.size() << " " << b[0][1] << std::endl;
+
+    sjtu::vector<std::string> w = make_words(30);
+    std::cout << w.size() << " " << w[29] << std::endl;
+}
+
+void TestMoveRegrowth() {
+    std::cout << "Testing regrowth moves instead of copying..." << std::endl;
+    Tracked::copies = Tracked::moves = 0;
+    sjtu::vector<Tracked> v;
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back(Tracked(i));
+    }
+    std::cout << "copies: " << Tracked::copies << std::endl;
+    long long sum = 0;
+    for (size_t i = 0; i < v.size(); ++i) {
+        sum += v[i].value;
+    }
+    std::cout << "sum: " << sum << std::endl;
+
+    Tracked::copies = 0;
+    v.insert(v.begin(), Tracked(-5));
+    v.insert(v.begin() + 500, Tracked(-6));
+    v.erase(v.begin() + 1);
+    std::cout << "copies: " << Tracked::copies << " " << v[0].value << " "
+              << v[1].value << " " << v[499].value << " " << v.size() << std::endl;
+
+    MayThrow::copies = 0;
+    sjtu::vector<MayThrow> m;
+    for (int i = 0; i < 9; ++i) {
+        m.push_back(MayThrow(i));
+    }
+    std::cout << "throwing-move copies: " << MayThrow::copies << std::endl;
+}
+
+void TestSelfReference() {
+    std::cout << "Testing push_back of own elements..." << std::endl;
+    sjtu::vector<std::string> v;
+    v.push_back(std::string(64, 'x'));
+    for (int i = 0; i < 10; ++i) {
+        v.push_back(v[0]);
+    }
+    v.insert(v.begin(), v[3]);
+    bool ok = v.size() == 12;
+    for (size_t i = 0; i < v.size(); ++i) {
+        ok = ok && v[i] == std::string(64, 'x');
+    }
+    std::cout << (ok ? "OK" : "WRONG") << std::endl;
+}
+
+struct Point {
+    int x, y;
+    std::string tag;
+    Point(int x_, int y_, const std::string &tag_) : x(x_), y(y_), tag(tag_) {
+    }
+};
+
+void TestEmplace() {
+    std::cout << "Testing emplace_back and emplace..." << std::endl;
+    sjtu::vector<Integer> vInt;
+    for (int i = 1; i <= 100; ++i) {
+        vInt.emplace_back(i);
+    }
+    vInt.emplace(vInt.begin() + 50, 0);
+    vInt.emplace(0, -1);
+    std::cout << vInt.size() << " " << (vInt[51] == Integer(0)) << " "
+              << (vInt[0] == Integer(-1)) << std::endl;
+
+    sjtu::vector<Point> pts;
+    for (int i = 0; i < 5; ++i) {
+        Point &p = pts.emplace_back(i, i * i, "p" + std::to_string(i));
+        p.y += 1;
+    }
+    pts.emplace(pts.begin() + 2, 9, 9, "mid");
+    pts.emplace(pts.end(), 8, 8, "end");
+    for (size_t i = 0; i < pts.size(); ++i) {
+        std::cout << pts[i].tag << "(" << pts[i].x << "," << pts[i].y << ") ";
+    }
+    std::cout << std::endl;
+
+    Tracked::copies = Tracked::moves = 0;
+    sjtu::vector<Tracked> v;
+    for (int i = 0; i < 100; ++i) {
+        v.emplace_back(i);
+    }
+    int growth_moves = Tracked::moves;
+    v.emplace(v.begin() + 10, 1000);
+    std::cout << "copies: " << Tracked::copies << ", growth moves: " << growth_moves
+              << ", " << v[10].value << " " << v[11].value << std::endl;
+
+    sjtu::vector<std::string> s;
+    s.emplace_back(3, 'z');
+    for (int i = 0; i < 6; ++i) {
+        s.emplace(s.begin(), s.back());
+    }
+    s.emplace(s.begin() + 3, "abc", 2);
+    for (size_t i = 0; i < s.size(); ++i) {
+        std::cout << s[i] << " ";
+    }
+    std::cout << std::endl;
+    try {
+        s.emplace(100, "x");
+    } catch (...) {
+        std::cout << "exceptions thrown correctly." << std::endl;
+    }
+}
+
+int main() {
+    TestMoveConstruct();
+    TestMoveRegrowth();
+    TestSelfReference();
+    TestEmplace();
+    return 0;
+}
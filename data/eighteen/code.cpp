@@ -0,0 +1,112 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+template <typename T>
+void Print(const sjtu::vector<T> &v) {
+    std::cout << v.size() << ":";
+    for (size_t i = 0; i < v.size(); ++i) {
+        std::cout << " " << v[i];
+    }
+    std::cout << std::endl;
+}
+
+// Copying throws once the budget runs out.
+struct Fragile {
+    static int budget;
+    int value;
+    Fragile(int v = 0) : value(v) {}
+    Fragile(const Fragile &other) : value(other.value) {
+        if (budget-- == 0) {
+            throw 1;
+        }
+    }
+    Fragile &operator=(const Fragile &) = default;
+};
+int Fragile::budget = -1;
+
+void TestResize() {
+    std::cout << "Testing resize..." << std::endl;
+    sjtu::vector<int> v;
+    v.resize(5);
+    Print(v);
+    v.resize(8, 7);
+    Print(v);
+    v.resize(3);
+    Print(v);
+    v.resize(6, v[2]);
+    Print(v);
+    sjtu::vector<std::string> s;
+    s.resize(3, "x");
+    s.resize(4);
+    s.resize(100, s[0]);
+    std::cout << s.size() << " [" << s[3] << "] " << s[99] << std::endl;
+}
+
+void TestResizeDefaultInit() {
+    std::cout << "Testing resize_default_init..." << std::endl;
+    sjtu::vector<unsigned char> buf;
+    buf.resize_default_init(1 << 16);
+    for (size_t i = 0; i < buf.size(); ++i) {
+        buf[i] = static_cast<unsigned char>(i);
+    }
+    std::cout << buf.size() << " " << int(buf[255]) << " " << int(buf[256]) << std::endl;
+    buf.resize_default_init(10);
+    std::cout << buf.size() << std::endl;
+    sjtu::vector<std::string> s;
+    s.resize_default_init(2);
+    std::cout << s.size() << " [" << s[1] << "]" << std::endl;
+}
+
+void TestAssign() {
+    std::cout << "Testing assign..." << std::endl;
+    sjtu::vector<int> v;
+    v.assign(4, 9);
+    Print(v);
+    size_t cap = v.capacity();
+    v.assign({1, 2, 3});
+    Print(v);
+    std::cout << (v.capacity() == cap) << std::endl;
+    int arr[] = {5, 6, 7, 8, 9, 10};
+    v.assign(arr, arr + 6);
+    Print(v);
+    std::istringstream in("11 12 13");
+    v.assign(std::istream_iterator<int>(in), std::istream_iterator<int>());
+    Print(v);
+    sjtu::vector<std::string> s;
+    s.push_back("old");
+    s.assign(3, "new");
+    std::cout << s[0] << " " << s[2] << " " << s.size() << std::endl;
+    s.assign(1, s[2]);
+    std::cout << s[0] << " " << s.size() << std::endl;
+}
+
+void TestStrongGuarantee() {
+    std::cout << "Testing failed assign and resize..." << std::endl;
+    sjtu::vector<Fragile> v;
+    v.resize(3, Fragile(1));
+    Fragile::budget = 5;
+    try {
+        v.assign(10, Fragile(2));
+    } catch (int) {
+        std::cout << "assign threw, size " << v.size() << " value " << v[0].value << std::endl;
+    }
+    Fragile::budget = 2;
+    try {
+        v.resize(10, Fragile(3));
+    } catch (int) {
+        std::cout << "resize threw, size " << v.size() << " value " << v[2].value << std::endl;
+    }
+    Fragile::budget = -1;
+}
+
+int main() {
+    TestResize();
+    TestResizeDefaultInit();
+    TestAssign();
+    TestStrongGuarantee();
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include "devector.hpp"
+
+#include "class-integer.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+template <typename T>
+void print(const sjtu::devector<T> &v) {
+    for (typename sjtu::devector<T>::const_iterator it = v.cbegin(); it != v.cend(); ++it) {
+        std::cout << *it << " ";
+    }
+    std::cout << std::endl;
+}
+
+void TestFrontBack() {
+    std::cout << "Testing push_front and pop_front..." << std::endl;
+    sjtu::devector<int> d;
+    for (int i = 0; i < 5; ++i) {
+        d.push_front(i);
+        d.push_back(10 + i);
+    }
+    print(d);
+    d.pop_front();
+    d.pop_back();
+    std::cout << d.front() << " " << d.back() << " " << d.size() << std::endl;
+    const int *raw = d.data();
+    std::cout << raw[0] << " " << raw[d.size() - 1] << std::endl;
+
+    sjtu::devector<long long> q;
+    for (long long i = 0; i < 1 << 20; ++i) {
+        q.push_back(i);
+    }
+    for (long long i = 0; i < 1 << 11; ++i) {
+        q.push_front(-i);
+    }
+    for (int i = 0; i < 1 << 10; ++i) {
+        q.pop_front();
+    }
+    std::cout << q.front() << " " << q.back() << " " << q.size() << std::endl;
+
+    sjtu::devector<long long> fifo;
+    long long sum = 0;
+    for (long long i = 0; i < 1000000; ++i) {
+        fifo.push_back(i);
+        if (i % 3 == 2) {
+            sum += fifo.front();
+            fifo.pop_front();
+            sum += fifo.front();
+            fifo.pop_front();
+        }
+    }
+    std::cout << sum << " " << fifo.size() << " " << (fifo.capacity() < 2000000) << std::endl;
+    try {
+        sjtu::devector<int> e;
+        e.pop_front();
+    } catch (...) {
+        std::cout << "exceptions thrown correctly." << std::endl;
+    }
+}
+
+void TestInsertErase() {
+    std::cout << "Testing insert and erase..." << std::endl;
+    sjtu::devector<std::string> d;
+    for (int i = 0; i < 8; ++i) {
+        d.push_back(std::to_string(i));
+    }
+    d.insert(d.begin() + 1, "a");
+    d.insert(d.begin() + 7, "b");
+    d.insert(0, "c");
+    d.insert(d.end(), d[0]);
+    print(d);
+    d.erase(d.begin() + 2);
+    d.erase(d.begin() + 8);
+    d.erase(0);
+    print(d);
+    for (int i = 0; i < 20; ++i) {
+        d.insert(d.begin() + 1, d[i]);
+    }
+    std::cout << d.size() << " " << d[1] << " " << d[20] << " " << d.back() << std::endl;
+    try {
+        d.erase(d.end());
+    } catch (...) {
+        std::cout << "exceptions thrown correctly." << std::endl;
+    }
+}
+
+void TestCopyMove() {
+    std::cout << "Testing copy and move..." << std::endl;
+    sjtu::devector<Integer> a;
+    for (int i = 0; i < 100; ++i) {
+        a.push_front(Integer(i));
+        a.emplace_back(i);
+    }
+    sjtu::devector<Integer> b(a);
+    sjtu::devector<Integer> c;
+    c = b;
+    sjtu::devector<Integer> m(std::move(c));
+    std::cout << b.size() << " " << c.size() << " " << m.size() << " "
+              << (m[0] == Integer(99)) << " " << (m[199] == Integer(99)) << std::endl;
+    a.clear();
+    a.push_front(Integer(1));
+    std::cout << a.size() << std::endl;
+}
+
+// Wider than the alignment plain operator new guarantees.
+struct alignas(128) Wide {
+    std::string value;
+};
+
+void TestOverAligned() {
+    std::cout << "Testing over-aligned elements..." << std::endl;
+    sjtu::devector<Wide> v;
+    bool ok = true;
+    for (int i = 0; i < 500; ++i) {
+        v.push_back(Wide{std::to_string(i)});
+        v.push_front(Wide{std::to_string(-i)});
+        ok = ok && reinterpret_cast<std::uintptr_t>(&v[0]) % alignof(Wide) == 0;
+    }
+    std::cout << ok << " " << v.size() << " " << v[0].value << " " << v[999].value << std::endl;
+}
+
+int main() {
+    TestFrontBack();
+    TestInsertErase();
+    TestCopyMove();
+    TestOverAligned();
+    return 0;
+}
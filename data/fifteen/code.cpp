@@ -0,0 +1,89 @@
+#include "devector.hpp"
+#include "small_vector.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <type_traits>
+
+// Built twice, with and without SJTU_VECTOR_UNCHECKED_ITERATORS; the
+// output must not depend on the mode.
+
+template <typename It>
+void PrintCategory(const char *name) {
+    std::cout << name << " random access: "
+              << std::is_same<typename std::iterator_traits<It>::iterator_category,
+                              std::random_access_iterator_tag>::value
+              << std::endl;
+}
+
+void TestTraits() {
+    std::cout << "Testing iterator traits..." << std::endl;
+    PrintCategory<sjtu::vector<int>::iterator>("vector::iterator");
+    PrintCategory<sjtu::vector<int>::const_iterator>("vector::const_iterator");
+    PrintCategory<sjtu::devector<int>::iterator>("devector::iterator");
+    PrintCategory<sjtu::small_vector<int, 4>::iterator>("small_vector::iterator");
+    std::cout << std::is_same<sjtu::vector<int>::iterator::difference_type, std::ptrdiff_t>::value
+              << std::endl;
+}
+
+void TestAlgorithms() {
+    std::cout << "Testing standard algorithms..." << std::endl;
+    sjtu::vector<int> v;
+    for (int i = 0; i < 20; ++i) {
+        v.push_back((i * 7) % 20);
+    }
+    std::sort(v.begin(), v.end());
+    for (auto x : v) {
+        std::cout << x << " ";
+    }
+    std::cout << std::endl;
+    std::cout << std::binary_search(v.begin(), v.end(), 13) << " "
+              << (std::lower_bound(v.begin(), v.end(), 13) - v.begin()) << std::endl;
+    sjtu::vector<int> w;
+    w.insert(w.begin(), 20, 0);
+    std::copy(v.begin() + 5, v.end(), w.begin());
+    std::reverse(w.begin(), w.end());
+    std::cout << w[0] << " " << w[14] << " " << w[15] << " "
+              << std::accumulate(w.begin(), w.end(), 0) << std::endl;
+
+    sjtu::devector<int> d;
+    for (int i = 0; i < 10; ++i) {
+        d.push_front(i);
+    }
+    std::sort(d.begin(), d.end());
+    std::cout << d.front() << " " << d.back() << " " << *std::max_element(d.begin(), d.end())
+              << std::endl;
+}
+
+void TestOperators() {
+    std::cout << "Testing iterator operators..." << std::endl;
+    sjtu::vector<std::string> v;
+    v.push_back("alpha");
+    v.push_back("beta");
+    v.push_back("gamma");
+    sjtu::vector<std::string>::iterator it = v.begin();
+    sjtu::vector<std::string>::const_iterator cit = v.cend();
+    std::cout << it->size() << " " << it[2] << " " << (cit - it) << " " << (it < cit) << " "
+              << (cit > it) << " " << (it + 3 == cit) << " " << *(2 + it) << std::endl;
+    cit = it;
+    ++it;
+    std::cout << (cit <= it) << " " << (cit >= it) << " " << (it != cit) << " " << *cit << std::endl;
+    sjtu::vector<std::string>::iterator erased = v.erase(v.begin() + 1);
+    std::cout << *erased << " " << v.size() << std::endl;
+    const sjtu::vector<std::string> &cv = v;
+    for (const std::string &s : cv) {
+        std::cout << s << " ";
+    }
+    std::cout << std::endl;
+}
+
+int main() {
+    TestTraits();
+    TestAlgorithms();
+    TestOperators();
+    return 0;
+}
@@ -0,0 +1,238 @@
+#include "small_vector.hpp"
+
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+
+void TestInlineAndSpill() {
+    std::cout << "Testing inline storage and spilling..." << std::endl;
+    sjtu::small_vector<int, 4> v;
+    std::cout << v.capacity() << " " << v.is_inline() << std::endl;
+    for (int i = 0; i < 4; ++i) {
+        v.push_back(i);
+    }
+    std::cout << v.size() << " " << v.is_inline() << std::endl;
+    v.push_back(4);
+    std::cout << v.size() << " " << v.capacity() << " " << v.is_inline() << std::endl;
+    for (int i = 5; i < 20; ++i) {
+        v.push_back(i);
+    }
+    v.insert(v.begin() + 3, 100);
+    v.erase(v.begin());
+    for (sjtu::small_vector<int, 4>::iterator it = v.begin(); it != v.end(); ++it) {
+        std::cout << *it << " ";
+    }
+    std::cout << std::endl;
+    while (v.size() > 3) {
+        v.pop_back();
+    }
+    v.shrink_to_fit();
+    std::cout << v.size() << " " << v.capacity() << " " << v.is_inline() << " " << v[0] << " "
+              << v.back() << std::endl;
+}
+
+void TestCopyAndMove() {
+    std::cout << "Testing copy and move..." << std::endl;
+    sjtu::small_vector<std::string, 2> a{"one", "two"};
+    sjtu::small_vector<std::string, 2> b(a);
+    b[0] = "uno";
+    std::cout << a[0] << " " << b[0] << " " << b.is_inline() << std::endl;
+    sjtu::small_vector<std::string, 2> c(std::move(a));
+    std::cout << c[1] << " " << a.size() << " " << c.is_inline() << std::endl;
+    for (int i = 0; i < 5; ++i) {
+        c.push_back(std::to_string(i));
+    }
+    const std::string *heap = c.data();
+    sjtu::small_vector<std::string, 2> d(std::move(c));
+    std::cout << d.size() << " " << (d.data() == heap) << " " << c.size() << " "
+              << c.is_inline() << std::endl;
+    b = d;
+    d = std::move(b);
+    std::cout << b.size() << " " << d.size() << " " << d.back() << std::endl;
+    // Inserting through an iterator moves rvalues, so move-only types work.
+    sjtu::small_vector<std::unique_ptr<int>, 2> u;
+    u.push_back(std::make_unique<int>(1));
+    u.push_back(std::make_unique<int>(3));
+    std::unique_ptr<int> two = std::make_unique<int>(2);
+    u.insert(u.begin() + 1, std::move(two));
+    u.insert(u.begin(), std::make_unique<int>(0));
+    std::cout << *u[0] << *u[1] << *u[2] << *u[3] << " " << (two == nullptr) << std::endl;
+}
+
+void TestNested() {
+    std::cout << "Testing vector of small vectors..." << std::endl;
+    sjtu::vector<sjtu::small_vector<int, 2>> rows;
+    for (int i = 0; i < 1000; ++i) {
+        rows.push_back(sjtu::small_vector<int, 2>{i, i + 1});
+    }
+    rows[7].push_back(99);
+    long long sum = 0;
+    for (size_t i = 0; i < rows.size(); ++i) {
+        for (size_t j = 0; j < rows[i].size(); ++j) {
+            sum += rows[i][j];
+        }
+    }
+    std::cout << sum << " " << rows[7].is_inline() << " " << rows[8].is_inline() << std::endl;
+}
+
+void TestExceptions() {
+    std::cout << "Testing exceptions..." << std::endl;
+    sjtu::small_vector<int, 3> v;
+    try {
+        v.back();
+    } catch (sjtu::container_is_empty &) {
+        std::cout << "container_is_empty" << std::endl;
+    }
+    v.push_back(1);
+    try {
+        v[1];
+    } catch (sjtu::index_out_of_bound &) {
+        std::cout << "index_out_of_bound" << std::endl;
+    }
+    sjtu::small_vector<int, 3> w;
+    try {
+        v.erase(w.begin());
+    } catch (sjtu::invalid_iterator &) {
+        std::cout << "invalid_iterator" << std::endl;
+    }
+    try {
+        *v.end();
+    } catch (sjtu::invalid_iterator &) {
+        std::cout << "invalid_iterator" << std::endl;
+    }
+}
+
+// A stateful allocator drawing from one of several pools; each pool
+// remembers its blocks and reports any block it did not hand out.
+struct Pool {
+    int id;
+    std::set<void *> blocks;
+};
+
+template <typename T, bool Propagate>
+struct PoolAllocator {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::integral_constant<bool, Propagate>;
+    using propagate_on_container_move_assignment = std::integral_constant<bool, Propagate>;
+    using propagate_on_container_swap = std::integral_constant<bool, Propagate>;
+
+    Pool *pool;
+
+    explicit PoolAllocator(Pool *pool_) : pool(pool_) {
+    }
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U, Propagate> &other) : pool(other.pool) {
+    }
+    template <typename U>
+    struct rebind {
+        using other = PoolAllocator<U, Propagate>;
+    };
+
+    T *allocate(size_t n) {
+        T *p = std::allocator<T>().allocate(n);
+        pool->blocks.insert(p);
+        return p;
+    }
+    void deallocate(T *p, size_t n) {
+        if (pool->blocks.erase(p) == 0) {
+            std::cout << "pool " << pool->id << " freeing foreign block!" << std::endl;
+        }
+        std::allocator<T>().deallocate(p, n);
+    }
+    bool operator==(const PoolAllocator &rhs) const {
+        return pool == rhs.pool;
+    }
+    bool operator!=(const PoolAllocator &rhs) const {
+        return pool != rhs.pool;
+    }
+};
+
+template <bool Propagate>
+void TestAllocators() {
+    std::cout << "Testing " << (Propagate ? "a propagating" : "a non-propagating")
+              << " stateful allocator..." << std::endl;
+    using Alloc = PoolAllocator<std::string, Propagate>;
+    using V = sjtu::small_vector<std::string, 2, Alloc>;
+    Pool one{1, {}}, two{2, {}};
+    {
+        V a{Alloc(&one)}, b{Alloc(&two)};
+        for (int i = 0; i < 10; ++i) a.push_back(std::to_string(i));
+        b.push_back("b");
+        b = std::move(a);
+        std::cout << b.size() << " " << b[9] << " " << a.size() << " "
+                  << b.get_allocator().pool->id << std::endl;
+        V c{Alloc(&one)};
+        c.push_back("c");
+        c = b;
+        std::cout << c.size() << " " << c[9] << " " << c.get_allocator().pool->id << std::endl;
+        V d{Alloc(&two)};
+        d.push_back("d");
+        c = d;
+        std::cout << c.size() << " " << c[0] << " " << c.is_inline() << std::endl;
+        V e{Alloc(Propagate ? &one : &two)};
+        for (int i = 0; i < 5; ++i) e.push_back("e" + std::to_string(i));
+        e.swap(d);
+        std::cout << e.size() << " " << e[0] << " " << d.size() << " " << d[4] << " "
+                  << d.is_inline() << " " << e.is_inline() << std::endl;
+        d.swap(e);
+        e = std::move(d);
+        std::cout << e.size() << " " << e.back() << " " << d.size() << std::endl;
+    }
+    std::cout << "blocks left: " << one.blocks.size() << " " << two.blocks.size() << std::endl;
+}
+
+// Moves throw once armed; copies never do.
+struct Fragile {
+    static int armed, live;
+    int value;
+    Fragile(int v) : value(v) {
+        ++live;
+    }
+    Fragile(const Fragile &o) : value(o.value) {
+        ++live;
+    }
+    Fragile(Fragile &&o) : value(o.value) {
+        if (armed && --armed == 0) throw sjtu::runtime_error();
+        ++live;
+    }
+    Fragile &operator=(const Fragile &) = default;
+    ~Fragile() {
+        --live;
+    }
+};
+int Fragile::armed = 0, Fragile::live = 0;
+
+void TestThrowingMoves() {
+    std::cout << "Testing throwing moves..." << std::endl;
+    {
+        sjtu::small_vector<Fragile, 4> a{1, 2, 3}, b{4};
+        Fragile::armed = 3;
+        try {
+            sjtu::small_vector<Fragile, 4> c(std::move(a));
+        } catch (sjtu::runtime_error &) {
+            std::cout << "move construction threw, live " << Fragile::live << std::endl;
+        }
+        Fragile::armed = 2;
+        try {
+            b = std::move(a);
+        } catch (sjtu::runtime_error &) {
+            std::cout << "move assignment threw, live " << Fragile::live << " size "
+                      << b.size() << std::endl;
+        }
+        Fragile::armed = 0;
+    }
+    std::cout << "live " << Fragile::live << std::endl;
+}
+
+int main() {
+    TestInlineAndSpill();
+    TestCopyAndMove();
+    TestNested();
+    TestExceptions();
+    TestAllocators<true>();
+    TestAllocators<false>();
+    TestThrowingMoves();
+    return 0;
+}
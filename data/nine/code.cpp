@@ -0,0 +1,117 @@
+#include "vector.hpp"
+
+#include "class-matrix.hpp"
+
+#include <iostream>
+#include <string>
+
+void TestReserve() {
+    std::cout << "Testing reserve and capacity..." << std::endl;
+    sjtu::vector<long long> v;
+    std::cout << v.capacity() << std::endl;
+    v.reserve(1 << 20);
+    std::cout << v.size() << " " << v.capacity() << std::endl;
+    v.push_back(0);
+    const long long *base = &v[0];
+    for (long long i = 1; i < 1 << 20; ++i) {
+        v.push_back(i);
+    }
+    std::cout << v.capacity() << " " << (&v[0] == base) << " " << v.back() << std::endl;
+    v.reserve(10);
+    std::cout << v.capacity() << std::endl;
+    v.push_back(0);
+    std::cout << v.size() << " " << (v.capacity() > v.size()) << std::endl;
+
+    sjtu::vector<std::string> s;
+    s.push_back("keep");
+    s.reserve(100);
+    std::cout << s.capacity() << " " << s[0] << std::endl;
+}
+
+void TestShrink() {
+    std::cout << "Testing shrink_to_fit..." << std::endl;
+    sjtu::vector<Diamond::Matrix<int>> m;
+    for (int i = 1; i <= 1926; ++i) {
+        m.push_back(Diamond::Matrix<int>(i % 3 + 1, i % 5 + 1, i));
+    }
+    for (int i = 0; i < 1234; ++i) {
+        m.pop_back();
+    }
+    std::cout << m.size() << " " << m.capacity() << std::endl;
+    m.shrink_to_fit();
+    std::cout << m.size() << " " << m.capacity() << " " << m[691][0][0] << std::endl;
+    m.clear();
+    m.shrink_to_fit();
+    std::cout << m.size() << " " << m.capacity() << std::endl;
+    m.push_back(Diamond::Matrix<int>(1, 1, 7));
+    std::cout << m.size() << " " << m[0][0][0] << std::endl;
+}
+
+template <typename Growth>
+void PrintGrowth(const char *name) {
+    sjtu::vector<int, sjtu::allocator<int>, Growth> v;
+    size_t last = 0;
+    std::cout << name << ":";
+    for (int i = 0; i < 3000; ++i) {
+        v.push_back(i);
+        if (v.capacity() != last) {
+            last = v.capacity();
+            std::cout << " " << last;
+        }
+    }
+    std::cout << std::endl;
+}
+
+struct Tripling {
+    static size_t grow(size_t cap, size_t need, size_t) {
+        size_t ncap = cap ? cap * 3 : 4;
+        return ncap < need ? need : ncap;
+    }
+    static size_t shrink(size_t size, size_t cap) {
+        return size == 0 ? 0 : cap;
+    }
+};
+
+void TestGrowthPolicy() {
+    std::cout << "Testing growth policies..." << std::endl;
+    PrintGrowth<sjtu::growth::doubling>("doubling");
+    PrintGrowth<sjtu::growth::one_and_half>("one_and_half");
+    PrintGrowth<sjtu::growth::fibonacci>("fibonacci");
+    PrintGrowth<sjtu::growth::page_granular<>>("page_granular");
+    PrintGrowth<Tripling>("tripling");
+
+    sjtu::vector<std::string, sjtu::allocator<std::string>,
+                 sjtu::growth::shrink_with_hysteresis<>>
+        h;
+    for (int i = 0; i < 1025; ++i) {
+        h.push_back(std::to_string(i));
+    }
+    std::cout << h.size() << " " << h.capacity() << std::endl;
+    for (int round = 0; round < 1000; ++round) {
+        for (int i = 0; i < 16; ++i) {
+            h.pop_back();
+        }
+        for (int i = 0; i < 16; ++i) {
+            h.push_back(std::to_string(round));
+        }
+    }
+    std::cout << h.size() << " " << h.capacity() << " " << h.back() << std::endl;
+    h.erase(h.begin(), h.begin() + 700);
+    std::cout << h.size() << " " << h.capacity() << " " << h[0] << std::endl;
+    h.pop_back(300);
+    std::cout << h.size() << " " << h.capacity() << " " << h.back() << std::endl;
+    h.clear();
+    std::cout << h.size() << " " << h.capacity() << std::endl;
+
+    sjtu::vector<int, sjtu::allocator<int>, Tripling> t;
+    t.push_back(1);
+    t.pop_back();
+    std::cout << t.size() << " " << t.capacity() << std::endl;
+}
+
+int main() {
+    TestReserve();
+    TestShrink();
+    TestGrowthPolicy();
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+template <typename T>
+void Print(const sjtu::vector<T> &v) {
+    std::cout << v.size() << "/" << v.capacity() << ":";
+    for (size_t i = 0; i < v.size(); ++i) {
+        std::cout << " " << v[i];
+    }
+    std::cout << std::endl;
+}
+
+struct Fragile {
+    static int budget;
+    static int alive;
+    int value;
+    Fragile(int v = 0) : value(v) { ++alive; }
+    Fragile(const Fragile &other) : value(other.value) {
+        if (budget-- == 0) {
+            throw 1;
+        }
+        ++alive;
+    }
+    ~Fragile() { --alive; }
+};
+int Fragile::budget = -1;
+int Fragile::alive = 0;
+
+void TestFill() {
+    std::cout << "Testing fill constructors..." << std::endl;
+    Print(sjtu::vector<int>(4));
+    Print(sjtu::vector<int>(5, 0));
+    Print(sjtu::vector<int>(3, -1));
+    Print(sjtu::vector<int>(3, 258));
+    Print(sjtu::vector<char>(6, 'z'));
+    Print(sjtu::vector<double>(2, 1.5));
+    Print(sjtu::vector<std::string>(3, "ab"));
+    Print(sjtu::vector<std::string>(2));
+    Print(sjtu::vector<long long>(0, 7));
+}
+
+void TestRanges() {
+    std::cout << "Testing range constructors..." << std::endl;
+    int arr[] = {3, 1, 4, 1, 5, 9, 2, 6};
+    sjtu::vector<int> a(arr, arr + 8);
+    Print(a);
+    sjtu::vector<long long> widened(arr + 2, arr + 5);
+    Print(widened);
+    sjtu::vector<int> b(a.begin() + 1, a.end() - 1);
+    Print(b);
+    std::istringstream in("10 20 30");
+    sjtu::vector<int> c{std::istream_iterator<int>(in), std::istream_iterator<int>()};
+    Print(c);
+    sjtu::vector<int> d{2, 7, 1, 8};
+    Print(d);
+    sjtu::vector<std::string> e{"x", "yy", "zzz"};
+    Print(e);
+    sjtu::vector<int> f(d);
+    f[0] = 0;
+    Print(f);
+    Print(d);
+}
+
+void TestExceptions() {
+    std::cout << "Testing failed construction..." << std::endl;
+    Fragile proto(5);
+    Fragile::budget = 3;
+    try {
+        sjtu::vector<Fragile> v(10, proto);
+    } catch (int) {
+        std::cout << "fill threw, alive " << Fragile::alive << std::endl;
+    }
+    Fragile arr[6];
+    Fragile::budget = 4;
+    try {
+        sjtu::vector<Fragile> v(arr, arr + 6);
+    } catch (int) {
+        std::cout << "range threw, alive " << Fragile::alive << std::endl;
+    }
+    Fragile::budget = -1;
+}
+
+int main() {
+    TestFill();
+    TestRanges();
+    TestExceptions();
+    return 0;
+}
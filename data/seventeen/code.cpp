@@ -0,0 +1,114 @@
+#include "devector.hpp"
+#include "small_vector.hpp"
+#include "span.hpp"
+#include "vector.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+
+long long Sum(sjtu::span<const long long> s) {
+    long long total = 0;
+    for (long long x : s) {
+        total += x;
+    }
+    return total;
+}
+
+void Double(sjtu::span<long long> s) {
+    for (size_t i = 0; i < s.size(); ++i) {
+        s[i] *= 2;
+    }
+}
+
+void TestData() {
+    std::cout << "Testing data()..." << std::endl;
+    sjtu::vector<int> v;
+    std::cout << (v.data() == nullptr) << std::endl;
+    for (int i = 0; i < 8; ++i) {
+        v.push_back(i);
+    }
+    int raw[8];
+    std::memcpy(raw, v.data(), 8 * sizeof(int));
+    std::cout << raw[0] << " " << raw[7] << " " << (v.data() == &v[0]) << std::endl;
+    const sjtu::vector<int> &cv = v;
+    std::cout << cv.data()[3] << std::endl;
+}
+
+void TestSlices() {
+    std::cout << "Testing span slices..." << std::endl;
+    sjtu::vector<long long> v;
+    for (long long i = 1; i <= 100; ++i) {
+        v.push_back(i);
+    }
+    sjtu::span<long long> all(v);
+    std::cout << all.size() << " " << all.size_bytes() << " " << Sum(all) << std::endl;
+    // Four workers, a quarter each.
+    long long total = 0;
+    for (size_t w = 0; w < 4; ++w) {
+        total += Sum(all.subspan(w * 25, 25));
+    }
+    std::cout << total << " " << Sum(all.first(10)) << " " << Sum(all.last(10)) << " "
+              << Sum(all.subspan(90)) << std::endl;
+    Double(all.subspan(0, 3));
+    std::cout << v[0] << " " << v[2] << " " << v[3] << std::endl;
+
+    const sjtu::vector<long long> &cv = v;
+    sjtu::span<const long long> view = cv;
+    sjtu::span<const long long> from_mutable = all;
+    std::cout << view.front() << " " << view.back() << " " << from_mutable[50] << std::endl;
+
+    sjtu::span deduced = v;
+    deduced[99] = -1;
+    std::cout << v.back() << std::endl;
+}
+
+void TestOtherSources() {
+    std::cout << "Testing other sources..." << std::endl;
+    sjtu::devector<std::string> d;
+    d.push_back("b");
+    d.push_front("a");
+    sjtu::span<std::string> ds(d);
+    std::cout << ds[0] << ds[1] << std::endl;
+    sjtu::small_vector<int, 4> s{1, 2, 3};
+    sjtu::span<const int> ss(s);
+    int arr[] = {5, 6, 7};
+    sjtu::span<int> as(arr);
+    std::cout << ss.size() << " " << ss.back() << " " << as.last(1)[0] << " "
+              << sjtu::span<int>().empty() << std::endl;
+}
+
+void TestExceptions() {
+    std::cout << "Testing exceptions..." << std::endl;
+    sjtu::vector<int> v;
+    v.push_back(1);
+    sjtu::span<int> s(v);
+    try {
+        s.subspan(2);
+    } catch (sjtu::index_out_of_bound &) {
+        std::cout << "index_out_of_bound" << std::endl;
+    }
+    try {
+        s.first(2);
+    } catch (sjtu::index_out_of_bound &) {
+        std::cout << "index_out_of_bound" << std::endl;
+    }
+    try {
+        s.at(1);
+    } catch (sjtu::index_out_of_bound &) {
+        std::cout << "index_out_of_bound" << std::endl;
+    }
+    try {
+        s.subspan(1).front();
+    } catch (sjtu::container_is_empty &) {
+        std::cout << "container_is_empty" << std::endl;
+    }
+}
+
+int main() {
+    TestData();
+    TestSlices();
+    TestOtherSources();
+    TestExceptions();
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include "devector.hpp"
+#include "small_vector.hpp"
+#include "vector.hpp"
+
+#include <iostream>
+
+// Built with SJTU_VECTOR_UNCHECKED: operator[] and iterators no longer
+// check, while at(), front() and back() still throw.
+
+void TestUncheckedAccess() {
+    std::cout << "Testing unchecked access..." << std::endl;
+    sjtu::vector<long long> v;
+    for (long long i = 0; i < 1000; ++i) {
+        v.push_back(i * i);
+    }
+    long long sum = 0;
+    for (size_t i = 0; i < v.size(); ++i) {
+        sum += v[i];
+    }
+    for (sjtu::vector<long long>::iterator it = v.begin(); it != v.end(); ++it) {
+        sum -= *it;
+    }
+    v[10] = -1;
+    std::cout << sum << " " << v[10] << " " << v[999] << std::endl;
+
+    sjtu::devector<int> d;
+    sjtu::small_vector<int, 4> s;
+    for (int i = 0; i < 6; ++i) {
+        d.push_front(i);
+        s.push_back(i);
+    }
+    std::cout << d[0] << " " << d[5] << " " << s[0] << " " << s[5] << std::endl;
+}
+
+void TestCheckedAt() {
+    std::cout << "Testing that at() still checks..." << std::endl;
+    sjtu::vector<int> v;
+    v.push_back(1);
+    try {
+        v.at(1);
+    } catch (sjtu::index_out_of_bound &) {
+        std::cout << "vector index_out_of_bound" << std::endl;
+    }
+    sjtu::devector<int> d;
+    try {
+        d.at(0);
+    } catch (sjtu::index_out_of_bound &) {
+        std::cout << "devector index_out_of_bound" << std::endl;
+    }
+    sjtu::small_vector<int, 2> s;
+    try {
+        s.at(5);
+    } catch (sjtu::index_out_of_bound &) {
+        std::cout << "small_vector index_out_of_bound" << std::endl;
+    }
+    v.pop_back();
+    try {
+        v.front();
+    } catch (sjtu::container_is_empty &) {
+        std::cout << "container_is_empty" << std::endl;
+    }
+}
+
+int main() {
+    TestUncheckedAccess();
+    TestCheckedAt();
+    return 0;
+}
@@ -0,0 +1,161 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <string>
+#include <iterator>
+
+template <typename T>
+void print(const sjtu::vector<T> &v) {
+    for (size_t i = 0; i < v.size(); ++i) {
+        std::cout << v[i] << " ";
+    }
+    std::cout << std::endl;
+}
+
+void TestCountInsert() {
+    std::cout << "Testing insert(pos, n, value)..." << std::endl;
+    sjtu::vector<int> v;
+    for (int i = 0; i < 5; ++i) {
+        v.push_back(i);
+    }
+    v.insert(v.begin() + 2, 3, 7);
+    print(v);
+    v.insert(0, 2, -1);
+    v.insert(v.end(), 1, 9);
+    v.insert(v.begin(), 0, 100);
+    print(v);
+
+    sjtu::vector<std::string> s;
+    s.push_back("a");
+    s.push_back("b");
+    s.push_back("c");
+    s.reserve(16);
+    s.insert(s.begin() + 1, 2, s[2]);
+    print(s);
+    s.insert(s.begin() + 4, 5, std::string("x"));
+    print(s);
+}
+
+void TestRangeInsert() {
+    std::cout << "Testing insert(pos, first, last)..." << std::endl;
+    sjtu::vector<long long> v;
+    for (long long i = 0; i < 1 << 20; ++i) {
+        v.push_back(i);
+    }
+    sjtu::vector<long long> front;
+    for (long long i = 0; i < 1 << 11; ++i) {
+        front.push_back(-i);
+    }
+    v.insert(v.begin(), front.begin(), front.end());
+    std::cout << v.size() << " " << v[0] << " " << v[2047] << " " << v[2048] << " "
+              << v.back() << std::endl;
+
+    std::list<std::string> words = {"one", "two", "three"};
+    sjtu::vector<std::string> s;
+    for (int i = 0; i < 6; ++i) {
+        s.push_back(std::to_string(i));
+    }
+    s.insert(s.begin() + 5, words.begin(), words.end());
+    print(s);
+    s.shrink_to_fit();
+    s.insert(s.begin() + 1, words.begin(), words.end());
+    print(s);
+    s.reserve(64);
+    s.insert(s.begin() + 10, words.begin(), words.end());
+    print(s);
+
+    std::istringstream in("7 8 9");
+    sjtu::vector<int> w;
+    w.push_back(1);
+    w.push_back(2);
+    w.insert(w.begin() + 1, std::istream_iterator<int>(in), std::istream_iterator<int>());
+    print(w);
+
+    w.insert(w.begin(), {10, 20, 30});
+    w.insert(2, {});
+    print(w);
+}
+
+void TestAppend() {
+    std::cout << "Testing append..." << std::endl;
+    sjtu::vector<int> v;
+    const int raw[] = {1, 2, 3, 4};
+    v.append(raw, 4);
+    v.shrink_to_fit();
+    const int *self = &v[0];
+    v.append(self, 4);
+    v.append(raw, 0);
+    print(v);
+
+    sjtu::vector<std::string> s;
+    s.push_back("p");
+    s.push_back("q");
+    s.shrink_to_fit();
+    s.append(&s[0], 2);
+    print(s);
+    try {
+        v.insert(100, 2, 0);
+    } catch (...) {
+        std::cout << "exceptions thrown correctly." << std::endl;
+    }
+}
+
+void TestRangeErase() {
+    std::cout << "Testing erase(first, last), truncate and pop_back(n)..." << std::endl;
+    sjtu::vector<long long> v;
+    for (long long i = 0; i < 1 << 20; ++i) {
+        v.push_back(i);
+    }
+    sjtu::vector<long long>::iterator it = v.erase(v.begin(), v.begin() + 1024);
+    std::cout << v.size() << " " << *it << " " << v.front() << " " << v.back() << std::endl;
+    v.erase(v.begin() + 10, v.end());
+    print(v);
+    it = v.erase(v.begin() + 3, v.begin() + 3);
+    std::cout << *it << std::endl;
+    v.truncate(7);
+    v.truncate(100);
+    print(v);
+    v.pop_back(2);
+    print(v);
+    v.pop_back(5);
+    std::cout << v.size() << " " << v.empty() << std::endl;
+    try {
+        v.pop_back(1);
+    } catch (...) {
+        std::cout << "exceptions thrown correctly." << std::endl;
+    }
+
+    sjtu::vector<std::string> s;
+    for (int i = 0; i < 10; ++i) {
+        s.push_back(std::string(20, char('a' + i)));
+    }
+    s.erase(s.begin() + 2, s.begin() + 5);
+    s.erase(s.begin());
+    s.truncate(4);
+    for (size_t i = 0; i < s.size(); ++i) {
+        std::cout << s[i][0];
+    }
+    std::cout << std::endl;
+    sjtu::vector<std::string> other;
+    other.push_back("z");
+    try {
+        s.erase(s.begin() + 3, s.begin() + 1);
+    } catch (...) {
+        std::cout << "exceptions thrown correctly." << std::endl;
+    }
+    try {
+        s.erase(other.begin(), other.end());
+    } catch (...) {
+        std::cout << "exceptions thrown correctly." << std::endl;
+    }
+}
+
+int main() {
+    TestCountInsert();
+    TestRangeInsert();
+    TestAppend();
+    TestRangeErase();
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "arena.hpp"
+#include "vector.hpp"
+
+#include <iostream>
+#include <string>
+
+template <typename T>
+using arena_vector = sjtu::vector<T, sjtu::arena_allocator<T>>;
+
+void TestArenaVector() {
+    std::cout << "Testing vectors on an arena..." << std::endl;
+    sjtu::arena a(1 << 12);
+    {
+        arena_vector<long long> v{sjtu::arena_allocator<long long>(a)};
+        for (long long i = 0; i < 1 << 16; ++i) {
+            v.push_back(i);
+        }
+        v.insert(v.begin(), 2048, -1);
+        v.erase(v.begin(), v.begin() + 1024);
+        std::cout << v.size() << " " << v[0] << " " << v[1024] << " " << v.back() << std::endl;
+        std::cout << "blocks: " << a.block_count() << std::endl;
+
+        arena_vector<std::string> s{sjtu::arena_allocator<std::string>(a)};
+        for (int i = 0; i < 1000; ++i) {
+            s.push_back(std::to_string(i));
+        }
+        arena_vector<std::string> t(s);
+        t[0] = "copied";
+        std::cout << s[0] << " " << t[0] << " " << t[999] << " "
+                  << (t.get_allocator() == s.get_allocator()) << std::endl;
+    }
+    a.reset();
+    std::cout << "blocks after reset: " << a.block_count() << std::endl;
+    size_t reserved = a.bytes_reserved();
+    for (int request = 0; request < 100; ++request) {
+        arena_vector<int> v{sjtu::arena_allocator<int>(a)};
+        for (int i = 0; i < 10000; ++i) {
+            v.push_back(i);
+        }
+        a.reset();
+    }
+    std::cout << "steady state reuses the block: " << (a.bytes_reserved() == reserved) << " "
+              << a.block_count() << std::endl;
+}
+
+void TestArenaPrimitives() {
+    std::cout << "Testing arena primitives..." << std::endl;
+    sjtu::arena a(64);
+    char *p = static_cast<char *>(a.allocate(10, 1));
+    char *q = static_cast<char *>(a.reallocate(p, 10, 40, 1));
+    std::cout << (p == q) << std::endl;
+    void *r = a.allocate(8, 8);
+    std::cout << (reinterpret_cast<size_t>(r) % 8) << std::endl;
+    char *q2 = static_cast<char *>(a.reallocate(q, 40, 50, 1));
+    std::cout << (q2 == q) << std::endl;
+    a.deallocate(r, 8);
+    void *r2 = a.allocate(8, 8);
+    std::cout << (r2 != r) << " " << a.block_count() << std::endl;
+    void *big = a.allocate(1000, 16);
+    std::cout << (reinterpret_cast<size_t>(big) % 16) << " " << a.block_count() << std::endl;
+}
+
+int main() {
+    TestArenaVector();
+    TestArenaPrimitives();
+    return 0;
+}
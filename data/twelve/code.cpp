@@ -0,0 +1,152 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <memory>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// A stateful allocator that tags its memory with an id and counts live
+// blocks; Propagate controls all three propagation traits.
+template <typename T, bool Propagate>
+struct TaggedAllocator {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::integral_constant<bool, Propagate>;
+    using propagate_on_container_move_assignment = std::integral_constant<bool, Propagate>;
+    using propagate_on_container_swap = std::integral_constant<bool, Propagate>;
+
+    int id;
+    int *live;
+
+    TaggedAllocator(int id_, int *live_) : id(id_), live(live_) {
+    }
+    template <typename U>
+    TaggedAllocator(const TaggedAllocator<U, Propagate> &other) : id(other.id), live(other.live) {
+    }
+    template <typename U>
+    struct rebind {
+        using other = TaggedAllocator<U, Propagate>;
+    };
+
+    T *allocate(size_t n) {
+        ++*live;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T *p, size_t n) {
+        --*live;
+        std::allocator<T>().deallocate(p, n);
+    }
+    TaggedAllocator select_on_container_copy_construction() const {
+        return TaggedAllocator(id + 100, live);
+    }
+    bool operator==(const TaggedAllocator &rhs) const {
+        return id == rhs.id;
+    }
+    bool operator!=(const TaggedAllocator &rhs) const {
+        return id != rhs.id;
+    }
+};
+
+template <typename V>
+void fill(V &v, int n, int base) {
+    for (int i = 0; i < n; ++i) {
+        v.push_back(std::to_string(base + i));
+    }
+}
+
+void TestPropagating() {
+    std::cout << "Testing a propagating allocator..." << std::endl;
+    int live = 0;
+    using Alloc = TaggedAllocator<std::string, true>;
+    {
+        sjtu::vector<std::string, Alloc> a(Alloc(1, &live)), b(Alloc(2, &live));
+        fill(a, 20, 0);
+        fill(b, 3, 100);
+        sjtu::vector<std::string, Alloc> c(a);
+        std::cout << c.get_allocator().id << " " << c.size() << " " << c[19] << std::endl;
+        b = a;
+        std::cout << b.get_allocator().id << " " << b.size() << " " << b[0] << std::endl;
+        c = std::move(b);
+        std::cout << c.get_allocator().id << " " << b.size() << " " << c.size() << std::endl;
+        a.swap(c);
+        std::cout << a.get_allocator().id << " " << c.get_allocator().id << std::endl;
+        std::cout << "live blocks: " << live << std::endl;
+    }
+    std::cout << "live blocks: " << live << std::endl;
+}
+
+void TestNonPropagating() {
+    std::cout << "Testing a non-propagating allocator..." << std::endl;
+    int live = 0;
+    using Alloc = TaggedAllocator<std::string, false>;
+    {
+        sjtu::vector<std::string, Alloc> a(Alloc(1, &live)), b(Alloc(2, &live));
+        fill(a, 20, 0);
+        b = a;
+        std::cout << b.get_allocator().id << " " << b.size() << " " << b[7] << std::endl;
+        b = std::move(a);
+        std::cout << b.get_allocator().id << " " << b.size() << " " << b[7] << std::endl;
+        sjtu::vector<std::string, Alloc> c(std::move(b), Alloc(3, &live));
+        std::cout << c.get_allocator().id << " " << c.size() << " " << c[19] << std::endl;
+        sjtu::vector<std::string, Alloc> d(std::move(c), Alloc(3, &live));
+        std::cout << c.size() << " " << d.size() << std::endl;
+        std::cout << "live blocks: " << live << std::endl;
+    }
+    std::cout << "live blocks: " << live << std::endl;
+}
+
+void TestTrivialWithAllocator() {
+    std::cout << "Testing trivially copyable elements..." << std::endl;
+    int live = 0;
+    using Alloc = TaggedAllocator<long long, true>;
+    {
+        sjtu::vector<long long, Alloc> v(Alloc(7, &live));
+        for (long long i = 0; i < 100000; ++i) {
+            v.push_back(i);
+        }
+        v.insert(v.begin() + 3, 5, -1);
+        v.erase(v.begin(), v.begin() + 2);
+        v.shrink_to_fit();
+        std::cout << v.size() << " " << v.capacity() << " " << v[1] << " " << v[2] << " "
+                  << v.back() << " live blocks: " << live << std::endl;
+    }
+    std::cout << "live blocks: " << live << std::endl;
+    std::cout << (sizeof(sjtu::vector<long long>) == 3 * sizeof(void *)) << std::endl;
+}
+
+// Wider than the alignment plain operator new guarantees.
+struct alignas(128) Wide {
+    int value;
+};
+struct alignas(128) WideString {
+    std::string value;
+};
+
+template <typename T>
+bool aligned(const sjtu::vector<T> &v) {
+    return reinterpret_cast<std::uintptr_t>(v.data()) % alignof(T) == 0;
+}
+
+void TestOverAligned() {
+    std::cout << "Testing over-aligned elements..." << std::endl;
+    sjtu::vector<Wide> a;
+    sjtu::vector<WideString> b;
+    bool ok = true;
+    for (int i = 0; i < 1000; ++i) {
+        a.push_back(Wide{i});
+        b.push_back(WideString{std::to_string(i)});
+        ok = ok && aligned(a) && aligned(b);
+    }
+    a.shrink_to_fit();
+    b.shrink_to_fit();
+    ok = ok && aligned(a) && aligned(b);
+    std::cout << ok << " " << a[999].value << " " << b[999].value << std::endl;
+}
+
+int main() {
+    TestPropagating();
+    TestNonPropagating();
+    TestTrivialWithAllocator();
+    TestOverAligned();
+    return 0;
+}
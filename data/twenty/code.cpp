@@ -0,0 +1,88 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <string>
+
+struct Fragile {
+    static int budget;
+    int value;
+    Fragile(int v = 0) : value(v) {}
+    Fragile(const Fragile &other) : value(other.value) {
+        if (budget-- == 0) {
+            throw 1;
+        }
+    }
+    Fragile &operator=(const Fragile &other) {
+        if (budget-- == 0) {
+            throw 1;
+        }
+        value = other.value;
+        return *this;
+    }
+};
+int Fragile::budget = -1;
+
+void TestReuse() {
+    std::cout << "Testing buffer reuse..." << std::endl;
+    sjtu::vector<int> a, b;
+    for (int i = 0; i < 100; ++i) {
+        a.push_back(i);
+    }
+    for (int i = 0; i < 10; ++i) {
+        b.push_back(-i);
+    }
+    sjtu::vector<int> c(a);
+    const int *buffer = c.data();
+    c = b;
+    std::cout << c.size() << " " << c.capacity() << " " << (c.data() == buffer) << " " << c[9]
+              << std::endl;
+    c = a;
+    std::cout << c.size() << " " << (c.data() == buffer) << " " << c[99] << std::endl;
+    sjtu::vector<int> empty;
+    c = empty;
+    std::cout << c.size() << " " << c.capacity() << std::endl;
+    b = a;
+    std::cout << b.size() << " " << (b.capacity() >= 100) << " " << b[50] << std::endl;
+}
+
+void TestStrings() {
+    std::cout << "Testing non-trivial elements..." << std::endl;
+    sjtu::vector<std::string> a, b;
+    for (int i = 0; i < 8; ++i) {
+        a.push_back(std::string(20, char('a' + i)));
+    }
+    b.push_back("short");
+    b.push_back("lived");
+    sjtu::vector<std::string> c(a);
+    const std::string *buffer = c.data();
+    c = b;
+    std::cout << c.size() << " " << (c.data() == buffer) << " " << c[0] << c[1] << std::endl;
+    c = a;
+    std::cout << c.size() << " " << (c.data() == buffer) << " " << c[7] << std::endl;
+    a[0] = "changed";
+    std::cout << c[0] << std::endl;
+}
+
+void TestFailure() {
+    std::cout << "Testing failed assignment..." << std::endl;
+    sjtu::vector<Fragile> small, large;
+    small.push_back(Fragile(1));
+    for (int i = 0; i < 10; ++i) {
+        large.push_back(Fragile(2));
+    }
+    Fragile::budget = 4;
+    try {
+        small = large;
+    } catch (int) {
+        std::cout << "growing assignment threw, unchanged: " << small.size() << " "
+                  << small[0].value << std::endl;
+    }
+    Fragile::budget = -1;
+}
+
+int main() {
+    TestReuse();
+    TestStrings();
+    TestFailure();
+    return 0;
+}
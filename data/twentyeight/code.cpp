@@ -0,0 +1,85 @@
+#include "page_allocator.hpp"
+#include "vector.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+template <typename T, size_t HeapBelow = sjtu::detail::pages::huge_page_size,
+          bool Populate = false>
+using huge = sjtu::vector<T, sjtu::huge_page_allocator<T, HeapBelow, Populate>>;
+
+bool huge_aligned(const void *p) {
+    return reinterpret_cast<std::uintptr_t>(p) % sjtu::detail::pages::huge_page_size == 0;
+}
+
+template <typename V>
+bool holds_squares(const V &v, size_t n) {
+    bool ok = v.size() == n;
+    for (size_t i = 0; ok && i < n; ++i) ok = v[i] == (long long)(i * i);
+    return ok;
+}
+
+template <typename V>
+void TestGrowth(const char *name) {
+    std::cout << "Testing growth, " << name << "..." << std::endl;
+    V v;
+    for (size_t i = 0; i < 1000; ++i) v.push_back(i * i);
+    std::cout << holds_squares(v, 1000) << std::endl;
+    for (size_t i = 1000; i < 5000000; ++i) v.push_back(i * i);
+    std::cout << holds_squares(v, 5000000) << " " << huge_aligned(v.data()) << " "
+              << v.capacity() << std::endl;
+    v.reserve(20000000);
+    std::cout << holds_squares(v, 5000000) << " " << huge_aligned(v.data()) << std::endl;
+    v.shrink_to_fit();
+    std::cout << holds_squares(v, 5000000) << " " << v.capacity() << std::endl;
+    while (v.size() > 100) v.pop_back();
+    v.shrink_to_fit();
+    std::cout << holds_squares(v, 100) << " " << v.capacity() << std::endl;
+    V w(v);
+    v.clear();
+    v.shrink_to_fit();
+    std::cout << holds_squares(w, 100) << " " << v.capacity() << std::endl;
+}
+
+void TestNonTrivial() {
+    std::cout << "Testing non-trivial elements..." << std::endl;
+    huge<std::string> v;
+    for (int i = 0; i < 200000; ++i) v.push_back(std::to_string(i));
+    bool ok = true;
+    for (int i = 0; i < 200000; ++i) ok = ok && v[i] == std::to_string(i);
+    std::cout << ok << " " << huge_aligned(v.data()) << std::endl;
+    v.erase(v.begin() + 10, v.end());
+    v.shrink_to_fit();
+    std::cout << v.size() << " " << v.back() << std::endl;
+}
+
+void TestReallocate() {
+    std::cout << "Testing reallocate..." << std::endl;
+    sjtu::huge_page_allocator<int> alloc;
+    const size_t big = 1 << 20, small = 1000;
+    int *p = alloc.allocate(small);
+    for (size_t i = 0; i < small; ++i) p[i] = int(i);
+    p = alloc.reallocate(p, small, big);
+    bool ok = huge_aligned(p);
+    for (size_t i = 0; i < big; ++i) p[i] = int(i);
+    p = alloc.reallocate(p, big, 3 * big);
+    ok = ok && huge_aligned(p);
+    for (size_t i = 0; i < big; ++i) ok = ok && p[i] == int(i);
+    p = alloc.reallocate(p, 3 * big, small);
+    for (size_t i = 0; i < small; ++i) ok = ok && p[i] == int(i);
+    alloc.deallocate(p, small);
+    std::cout << ok << std::endl;
+    sjtu::huge_page_allocator<char> other(alloc);
+    std::cout << (alloc == other) << std::endl;
+}
+
+int main() {
+    TestGrowth<huge<long long>>("default threshold");
+    TestGrowth<huge<long long, 4096>>("4 KiB threshold");
+    TestGrowth<huge<long long, sjtu::detail::pages::huge_page_size, true>>("populated");
+    TestNonTrivial();
+    TestReallocate();
+    std::cout << "Finished!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,192 @@
+#include "flat_map.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+template <typename Set>
+void PrintSet(const Set &s) {
+    for (auto it = s.begin(); it != s.end(); ++it) {
+        std::cout << *it << " ";
+    }
+    std::cout << "(" << s.size() << ")" << std::endl;
+}
+
+template <typename Map>
+void PrintMap(const Map &m) {
+    for (auto it = m.begin(); it != m.end(); ++it) {
+        std::cout << (*it).first << "=" << it->second << " ";
+    }
+    std::cout << "(" << m.size() << ")" << std::endl;
+}
+
+void TestSet() {
+    std::cout << "Testing flat_set..." << std::endl;
+    sjtu::flat_set<int> s{5, 3, 9, 3, 1, 5, 7};
+    PrintSet(s);
+    std::cout << s.contains(7) << s.contains(4) << " " << *s.lower_bound(4) << " "
+              << *s.upper_bound(5) << " " << (s.find(2) == s.end()) << " "
+              << (s.upper_bound(9) == s.end()) << std::endl;
+    std::cout << s.insert(4).second << s.insert(4).second << " " << *s.insert(0).first << std::endl;
+    s.insert_range({8, 2, 2, 100, 6, 9});
+    PrintSet(s);
+    std::cout << s.erase(100) << s.erase(100) << std::endl;
+    s.erase(s.begin());
+    PrintSet(s);
+    // A batch that sorts after everything is appended.
+    sjtu::vector<int> tail;
+    for (int i = 20; i > 10; --i) {
+        tail.push_back(i);
+    }
+    s.insert_range(tail.begin(), tail.end());
+    PrintSet(s);
+
+    sjtu::flat_set<std::string, std::greater<std::string>> words(
+        sjtu::vector<std::string>{"pear", "apple", "fig", "apple", "kiwi"});
+    PrintSet(words);
+    std::cout << (words.find("fig") - words.begin()) << std::endl;
+
+    sjtu::flat_set<int> empty;
+    std::cout << (empty.lower_bound(1) == empty.end()) << empty.contains(0) << std::endl;
+}
+
+void TestMap() {
+    std::cout << "Testing flat_map..." << std::endl;
+    sjtu::flat_map<std::string, int> m{{"b", 2}, {"a", 1}, {"c", 3}, {"a", 100}};
+    PrintMap(m);
+    m["d"] = 4;
+    m["a"] += 10;
+    std::cout << m.insert("b", 20).second << m.insert("e", 5).second << " " << m.at("b") << std::endl;
+    m.insert_or_assign("b", 22);
+    PrintMap(m);
+    try {
+        m.at("zzz");
+    } catch (...) {
+        std::cout << "at(zzz) threw" << std::endl;
+    }
+    sjtu::vector<std::pair<std::string, int>> batch;
+    batch.push_back({"cc", 33});
+    batch.push_back({"aa", 11});
+    batch.push_back({"c", -1});
+    batch.push_back({"cc", -1});
+    batch.push_back({"0", 0});
+    m.insert_range(batch.begin(), batch.end());
+    PrintMap(m);
+    std::cout << m.erase("cc") << m.erase("cc") << " " << m.find("e")->second << std::endl;
+    auto it = m.erase(m.find("b"));
+    std::cout << it->first << " " << it.index() << std::endl;
+    PrintMap(m);
+    for (auto kv : m) {
+        kv.second *= 2;
+    }
+    PrintMap(m);
+
+    // Bulk construction from parallel vectors keeps the first value per key.
+    sjtu::vector<int> keys, values;
+    for (int i = 0; i < 1000; ++i) {
+        keys.push_back(i * 7919 % 500);
+        values.push_back(i);
+    }
+    sjtu::flat_map<int, int> big(keys, values);
+    std::cout << big.size() << " " << big.at(0) << " " << big.at(499) << " "
+              << big.keys()[250] << " " << big.values()[250] << std::endl;
+    try {
+        keys.push_back(1);
+        sjtu::flat_map<int, int> bad(keys, values);
+    } catch (...) {
+        std::cout << "mismatched sizes threw" << std::endl;
+    }
+}
+
+void TestIterators() {
+    std::cout << "Testing random access iterators..." << std::endl;
+    sjtu::flat_map<int, int> m;
+    for (int i = 0; i < 10; ++i) m.insert(i * 10, i);
+    auto it = m.begin() + 7;
+    it -= 2;
+    std::cout << it->first << " " << (it - 3)->first << " " << (2 + it)->first << " "
+              << it[1].second << std::endl;
+    std::cout << (it < m.end()) << (it > m.begin()) << (it <= it) << (it >= m.end()) << std::endl;
+    auto at = std::partition_point(m.begin(), m.end(),
+                                   [](std::pair<const int &, int &> kv) { return kv.first < 42; });
+    std::cout << at->first << " " << (m.end() - at) << std::endl;
+    sjtu::flat_map<int, int>::const_iterator c = m.begin();
+    c += 9;
+    std::cout << (c - 9)->first << " " << (c == m.end() - 1) << std::endl;
+}
+
+// Moves throw once armed; copies never do.
+struct Fragile {
+    static int armed;
+    int value;
+    Fragile(int v = 0) : value(v) {
+    }
+    Fragile(const Fragile &) = default;
+    Fragile(Fragile &&o) : value(o.value) {
+        if (armed && --armed == 0) throw sjtu::runtime_error();
+    }
+    Fragile &operator=(const Fragile &) = default;
+};
+int Fragile::armed = 0;
+
+void TestThrowingValues() {
+    std::cout << "Testing values whose moves throw..." << std::endl;
+    sjtu::flat_map<int, Fragile> m{{1, 10}, {2, 20}};
+    sjtu::vector<std::pair<int, Fragile>> tail{{5, 50}, {3, 30}, {4, 40}};
+    sjtu::vector<std::pair<int, Fragile>> mixed{{0, 0}, {6, 60}, {-1, -10}};
+    // Appending, then merging: each throws partway through its batch.
+    for (auto *batch : {&tail, &mixed}) {
+        Fragile::armed = 2;
+        try {
+            m.insert_range(batch->begin(), batch->end());
+        } catch (sjtu::runtime_error &) {
+            std::cout << "insert_range threw" << std::endl;
+        }
+        Fragile::armed = 0;
+        std::cout << m.size() << " " << m.keys().size() << " " << m.values().size() << " "
+                  << m.at(1).value << " " << m.at(2).value << std::endl;
+    }
+    m.insert(7, Fragile(70));
+    std::cout << m.size() << " " << m.at(7).value << std::endl;
+}
+
+// A key whose moves throw once armed; copies never do.
+struct FragileKey {
+    static int armed;
+    std::string name;
+    FragileKey(const char *n) : name(n) {
+    }
+    FragileKey(const FragileKey &) = default;
+    FragileKey(FragileKey &&o) : name(std::move(o.name)) {
+        if (armed && --armed == 0) throw sjtu::runtime_error();
+    }
+    FragileKey &operator=(const FragileKey &) = default;
+    bool operator<(const FragileKey &rhs) const {
+        return name < rhs.name;
+    }
+};
+int FragileKey::armed = 0;
+
+void TestThrowingKeys() {
+    std::cout << "Testing keys whose moves throw..." << std::endl;
+    sjtu::flat_set<FragileKey> s{"bbb", "ddd", "fff"};
+    FragileKey::armed = 3;
+    try {
+        s.insert_range({"aaa", "ccc", "eee"});
+    } catch (sjtu::runtime_error &) {
+        std::cout << "insert_range threw" << std::endl;
+    }
+    FragileKey::armed = 0;
+    for (const FragileKey &k : s) std::cout << k.name << " ";
+    std::cout << "(" << s.size() << ")" << std::endl;
+}
+
+int main() {
+    TestSet();
+    TestMap();
+    TestIterators();
+    TestThrowingValues();
+    TestThrowingKeys();
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "simd.hpp"
+#include "span.hpp"
+#include "vector.hpp"
+
+#include <iostream>
+#include <string>
+
+// Every test runs at each dispatch level up to what the machine supports
+// and prints one line per level, so the answer does not depend on it.
+template <typename Fn>
+void AtEachLevel(Fn fn) {
+    for (int l = 0; l <= 3; ++l) {
+        sjtu::simd::set_level(sjtu::simd::level(l));
+        fn();
+    }
+    sjtu::simd::set_level(sjtu::simd::supported_level());
+}
+
+void TestIntegers() {
+    std::cout << "Testing int and long long..." << std::endl;
+    sjtu::vector<int> a(100003);
+    sjtu::vector<long long> b(100003);
+    AtEachLevel([&] {
+        sjtu::simd::iota(a, -50000);
+        sjtu::simd::iota(b, 1LL << 40);
+        a[77777] = 1 << 30;
+        a[88888] = 1 << 30;
+        a[5] = -(1 << 30);
+        b[99999] = -1;
+        std::cout << sjtu::simd::sum(a) << " " << sjtu::simd::sum(b) << " "
+                  << sjtu::simd::min_element(a) << " " << sjtu::simd::max_element(a) << " "
+                  << sjtu::simd::min_element(b) << " " << sjtu::simd::max_element(b) << " "
+                  << sjtu::simd::find(a, 12345) << " " << sjtu::simd::find(a, 99999) << " "
+                  << sjtu::simd::count(a, 1 << 30) << std::endl;
+    });
+}
+
+void TestDoubles() {
+    std::cout << "Testing double..." << std::endl;
+    sjtu::vector<double> d(54321);
+    AtEachLevel([&] {
+        for (size_t i = 0; i < d.size(); ++i) {
+            d[i] = (i % 2 ? -1.0 : 1.0) / (i + 1);
+        }
+        std::cout.precision(17);
+        std::cout << sjtu::simd::sum(d) << " " << sjtu::simd::max_element(d) << " "
+                  << sjtu::simd::min_element(d) << " " << sjtu::simd::find(d, 0.25) << " "
+                  << sjtu::simd::find(d, -0.25) << std::endl;
+        sjtu::simd::iota(d, 0.5);
+        std::cout << d[0] << " " << d[54320] << " " << sjtu::simd::sum(d) << std::endl;
+        sjtu::simd::iota(d, -100.0);
+        std::cout << d[0] << " " << d[54320] << " " << sjtu::simd::sum(d) << std::endl;
+        sjtu::simd::fill(d, -0.0);
+        std::cout << sjtu::simd::count(d, 0.0) << " " << sjtu::simd::find(d, 0.0) << std::endl;
+    });
+}
+
+void TestSmallAndSpans() {
+    std::cout << "Testing short ranges and spans..." << std::endl;
+    sjtu::vector<long long> v(40, 7);
+    AtEachLevel([&] {
+        sjtu::span<long long> s(v);
+        sjtu::simd::iota(s.subspan(3, 20), 100LL);
+        std::cout << v[2] << " " << v[3] << " " << v[22] << " " << v[23] << " "
+                  << sjtu::simd::max_element(s.first(10)) << " "
+                  << sjtu::simd::count(s.last(17), 7LL) << std::endl;
+        sjtu::vector<int> empty;
+        std::cout << sjtu::simd::sum(empty) << " " << sjtu::simd::min_element(empty) << " "
+                  << sjtu::simd::find(empty, 0) << std::endl;
+    });
+    // Other element types use the scalar loops.
+    sjtu::vector<std::string> words(5, "b");
+    words[3] = "a";
+    sjtu::simd::fill(sjtu::span<std::string>(words).first(2), std::string("c"));
+    std::cout << sjtu::simd::sum(words) << " " << sjtu::simd::min_element(words) << " "
+              << sjtu::simd::count(words, std::string("b")) << std::endl;
+}
+
+int main() {
+    TestIntegers();
+    TestDoubles();
+    TestSmallAndSpans();
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <string>
+
+// Built as C++20: every vector below is created, used and destroyed
+// during constant evaluation.
+
+constexpr sjtu::vector<int> Primes(int limit) {
+    sjtu::vector<bool> composite(limit + 1, false);
+    sjtu::vector<int> primes;
+    for (int i = 2; i <= limit; ++i) {
+        if (composite[i]) {
+            continue;
+        }
+        primes.push_back(i);
+        for (int j = i * i; j <= limit; j += i) {
+            composite[j] = true;
+        }
+    }
+    return primes;
+}
+
+// Copies a compile-time vector into a static array of the right size.
+template <int Limit>
+struct PrimeTable {
+    static constexpr int size = static_cast<int>(Primes(Limit).size());
+    int values[size];
+    constexpr PrimeTable() : values() {
+        sjtu::vector<int> primes = Primes(Limit);
+        for (int i = 0; i < size; ++i) {
+            values[i] = primes[i];
+        }
+    }
+};
+
+constexpr PrimeTable<100> kPrimes;
+static_assert(kPrimes.size == 25);
+static_assert(kPrimes.values[24] == 97);
+
+constexpr long long Exercise() {
+    sjtu::vector<long long> v{5, 6, 7};
+    for (long long i = 0; i < 100; ++i) {
+        v.push_back(i);
+    }
+    v.insert(v.begin(), -1);
+    v.insert(v.begin() + 2, 3, 42);
+    v.erase(v.begin() + 10, v.begin() + 20);
+    v.resize(50);
+    v.resize(60, 1);
+    v.resize_default_init(70);
+    sjtu::vector<long long> w(v);
+    w.assign({1, 2, 3});
+    v = w;
+    v.emplace_back(10);
+    long long sum = 0;
+    for (sjtu::vector<long long>::iterator it = v.begin(); it != v.end(); ++it) {
+        sum += *it;
+    }
+    for (long long x : w) {
+        sum += x * 100;
+    }
+    return sum + static_cast<long long>(v.size()) * 1000 + (v.end() - v.begin());
+}
+static_assert(Exercise() == 4620);
+
+constexpr std::size_t Strings() {
+    sjtu::vector<std::string> s(3, "abc");
+    s.insert(s.begin() + 1, "middle");
+    s.erase(s.begin());
+    sjtu::vector<std::string> t;
+    t = s;
+    return t[0].size() + t.size();
+}
+static_assert(Strings() == 9);
+
+int main() {
+    for (int i = 0; i < kPrimes.size; ++i) {
+        std::cout << kPrimes.values[i] << " ";
+    }
+    std::cout << std::endl;
+    std::cout << Exercise() << " " << Strings() << std::endl;
+    sjtu::vector<int> runtime = Primes(30);
+    std::cout << runtime.size() << " " << runtime.back() << std::endl;
+    return 0;
+}
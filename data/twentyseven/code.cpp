@@ -0,0 +1,95 @@
+#include "page_allocator.hpp"
+#include "vector.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+template <typename T>
+using paged = sjtu::vector<T, sjtu::page_allocator<T>>;
+
+bool page_aligned(const void *p) {
+    return reinterpret_cast<std::uintptr_t>(p) % sjtu::detail::pages::page_size() == 0;
+}
+
+void TestGrowth() {
+    std::cout << "Testing growth..." << std::endl;
+    paged<int> v;
+    for (int i = 0; i < 3000000; ++i) v.push_back(i * 7);
+    bool ok = true;
+    for (int i = 0; i < 3000000; ++i) ok = ok && v[i] == i * 7;
+    std::cout << ok << " " << v.size() << " " << v.capacity() << " "
+              << page_aligned(v.data()) << std::endl;
+    v.insert(v.begin() + 5, -1);
+    v.erase(1000);
+    std::cout << v[4] << " " << v[5] << " " << v[6] << " " << v[1000] << std::endl;
+    for (int i = 0; i < 2900000; ++i) v.pop_back();
+    v.shrink_to_fit();
+    // -1 sits at 5, and the elements from 6 to 999 are shifted by one.
+    auto expected = [](int i) { return i == 5 ? -1 : i > 5 && i < 1000 ? (i - 1) * 7 : i * 7; };
+    ok = v.capacity() == v.size();
+    for (int i = 0; i < 100000; ++i) ok = ok && v[i] == expected(i);
+    std::cout << ok << " " << v.size() << " " << v.back() << std::endl;
+    v.reserve(5000000);
+    std::cout << v.capacity() << " " << v[99998] << std::endl;
+    v.clear();
+    v.shrink_to_fit();
+    std::cout << v.size() << " " << v.capacity() << std::endl;
+    v.push_back(42);
+    std::cout << v[0] << std::endl;
+}
+
+void TestCopies() {
+    std::cout << "Testing copies..." << std::endl;
+    paged<long long> a(100000, 3);
+    paged<long long> b(a);
+    b[99999] = 4;
+    paged<long long> c;
+    c = b;
+    c.swap(a);
+    std::cout << a[99999] << " " << b[99999] << " " << c[99999] << " "
+              << (a.data() != b.data()) << std::endl;
+    paged<long long> d(std::move(c));
+    std::cout << d.size() << " " << c.size() << std::endl;
+}
+
+void TestNonTrivial() {
+    std::cout << "Testing non-trivial elements..." << std::endl;
+    paged<std::string> v;
+    for (int i = 0; i < 20000; ++i) v.push_back(std::to_string(i));
+    v.erase(v.begin(), v.begin() + 10000);
+    std::cout << v.size() << " " << v[0] << " " << v.back() << " " << page_aligned(v.data())
+              << std::endl;
+}
+
+void TestReallocate() {
+    std::cout << "Testing reallocate..." << std::endl;
+    sjtu::page_allocator<unsigned> alloc;
+    const size_t n = 1 << 20;
+    unsigned *p = alloc.allocate(n);
+    for (size_t i = 0; i < n; ++i) p[i] = unsigned(i * 2654435761u);
+    p = alloc.reallocate(p, n, 3 * n);
+    bool ok = true;
+    for (size_t i = 0; i < n; ++i) ok = ok && p[i] == unsigned(i * 2654435761u);
+    p[3 * n - 1] = 1;
+    p = alloc.reallocate(p, 3 * n, n / 3);
+    for (size_t i = 0; i < n / 3; ++i) ok = ok && p[i] == unsigned(i * 2654435761u);
+    p = alloc.reallocate(p, n / 3, n / 3);
+    ok = ok && p[n / 3 - 1] == unsigned((n / 3 - 1) * 2654435761u);
+    alloc.deallocate(p, n / 3);
+    std::cout << ok << std::endl;
+    unsigned *q = alloc.reallocate(nullptr, 0, 10);
+    q[9] = 9;
+    std::cout << q[9] << " " << page_aligned(q) << std::endl;
+    alloc.deallocate(q, 10);
+    std::cout << (alloc == sjtu::page_allocator<char>()) << std::endl;
+}
+
+int main() {
+    TestGrowth();
+    TestCopies();
+    TestNonTrivial();
+    TestReallocate();
+    std::cout << "Finished!" << std::endl;
+    return 0;
+}
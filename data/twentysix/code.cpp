@@ -0,0 +1,157 @@
+#include "stable_vector.hpp"
+#include "class-matrix.hpp"
+#include "class-bint.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+struct Counted {
+    static int copies, moves, live;
+    int value;
+    Counted(int v) : value(v) { ++live; }
+    Counted(const Counted &o) : value(o.value) { ++copies, ++live; }
+    Counted(Counted &&o) noexcept : value(o.value) { ++moves, ++live; }
+    Counted &operator=(const Counted &o) {
+        value = o.value, ++copies;
+        return *this;
+    }
+    Counted &operator=(Counted &&o) noexcept {
+        value = o.value, ++moves;
+        return *this;
+    }
+    ~Counted() { --live; }
+};
+int Counted::copies = 0, Counted::moves = 0, Counted::live = 0;
+
+void TestBasics() {
+    std::cout << "Testing basics..." << std::endl;
+    sjtu::stable_vector<int, 16> v;
+    std::cout << v.size() << " " << v.empty() << " " << v.capacity() << std::endl;
+    for (int i = 0; i < 100; ++i) v.push_back(i * i);
+    std::cout << v.size() << " " << v[0] << " " << v[99] << " " << v.at(50) << std::endl;
+    std::cout << v.front() << " " << v.back() << " " << v.capacity() << std::endl;
+    try {
+        v.at(100);
+    } catch (...) {
+        std::cout << "at(100) threw" << std::endl;
+    }
+    v.pop_back();
+    std::cout << v.size() << " " << v.back() << std::endl;
+    long long sum = 0;
+    for (int x : v) sum += x;
+    std::cout << sum << " " << (v.end() - v.begin()) << std::endl;
+    std::cout << *std::max_element(v.begin(), v.end()) << std::endl;
+    std::sort(v.begin(), v.end(), [](int a, int b) { return a > b; });
+    std::cout << v[0] << " " << v[98] << std::endl;
+    v.clear();
+    std::cout << v.size() << " " << v.capacity() << std::endl;
+    v.shrink_to_fit();
+    std::cout << v.capacity() << std::endl;
+    v.reserve(33);
+    std::cout << v.capacity() << std::endl;
+    try {
+        v.back();
+    } catch (...) {
+        std::cout << "back() of empty threw" << std::endl;
+    }
+}
+
+void TestStableAddresses() {
+    std::cout << "Testing stable addresses..." << std::endl;
+    sjtu::stable_vector<std::string> v;
+    v.push_back("first");
+    std::string &first = v[0];
+    const std::string *where = &first;
+    sjtu::stable_vector<std::string>::iterator it = v.begin();
+    for (int i = 1; i < 100000; ++i) v.emplace_back(std::to_string(i));
+    std::cout << (&v[0] == where) << " " << first << " " << *it << " " << v[99999]
+              << std::endl;
+    v.pop_back();
+    v.erase(v.size() - 1);
+    std::cout << (&v[0] == where) << " " << v.size() << " " << v.back() << std::endl;
+}
+
+void TestNoRelocation() {
+    std::cout << "Testing that growth never relocates..." << std::endl;
+    {
+        sjtu::stable_vector<Counted, 8> v;
+        for (int i = 0; i < 1000; ++i) v.emplace_back(i);
+        std::cout << Counted::copies << " " << Counted::moves << " " << Counted::live
+                  << std::endl;
+        Counted c(5);
+        v.push_back(c);
+        v.push_back(Counted(6));
+        std::cout << Counted::copies << " " << Counted::moves << " " << v.size()
+                  << std::endl;
+        sjtu::stable_vector<Counted, 8> w(v);
+        std::cout << Counted::copies << " " << w.size() << " " << w[1001].value << std::endl;
+        sjtu::stable_vector<Counted, 8> m(std::move(w));
+        std::cout << Counted::copies << " " << Counted::moves << " " << w.size() << " "
+                  << m.size() << std::endl;
+    }
+    std::cout << Counted::live << std::endl;
+}
+
+void TestInsertErase() {
+    std::cout << "Testing insert and erase..." << std::endl;
+    sjtu::stable_vector<int, 4> v{1, 2, 3, 4, 5, 6, 7, 8, 9};
+    const int *head = &v[0];
+    v.insert(3, 100);
+    v.insert(v.begin() + 1, 200);
+    v.insert(v.end(), 300);
+    v.insert(0, v[5]);
+    for (int x : v) std::cout << x << " ";
+    std::cout << std::endl;
+    std::cout << (head == &v[0]) << std::endl;
+    v.erase(0);
+    v.erase(v.begin() + 2);
+    sjtu::stable_vector<int, 4>::iterator it = v.erase(v.end() - 1);
+    std::cout << (it == v.end()) << " " << v.size() << std::endl;
+    for (int x : v) std::cout << x << " ";
+    std::cout << std::endl;
+    try {
+        v.insert(v.size() + 1, 0);
+    } catch (...) {
+        std::cout << "insert past the end threw" << std::endl;
+    }
+    sjtu::stable_vector<int, 4> other{1, 2};
+    try {
+        v.erase(other.begin());
+    } catch (...) {
+        std::cout << "foreign iterator threw" << std::endl;
+    }
+    try {
+        std::cout << (v.begin() - other.begin()) << std::endl;
+    } catch (...) {
+        std::cout << "foreign difference threw" << std::endl;
+    }
+    v = other;
+    other.swap(v);
+    std::cout << v.size() << " " << other.size() << " " << v[1] << std::endl;
+}
+
+void TestMatrices() {
+    std::cout << "Testing heavy elements..." << std::endl;
+    sjtu::stable_vector<Diamond::Matrix<Util::Bint>> v;
+    for (int i = 1; i <= 1926; ++i) {
+        v.push_back(Diamond::Matrix<Util::Bint>(i % 8 + 1, i % 17 + 1, Util::Bint(i * 817)));
+    }
+    const Diamond::Matrix<Util::Bint> *first = &v[0];
+    for (int i = 0; i < 1234; ++i) v.pop_back();
+    for (int i = 0; i < 500; ++i) v.emplace_back(2, 2, Util::Bint(i));
+    std::cout << (first == &v[0]) << " " << v.size() << std::endl;
+    std::cout << v[0][0][0] << " " << v[691][0][0] << " " << v[692][1][1] << " "
+              << v[1191][1][1] << std::endl;
+}
+
+int main() {
+    TestBasics();
+    TestStableAddresses();
+    TestNoRelocation();
+    TestInsertErase();
+    TestMatrices();
+    std::cout << "Finished!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include "parallel.hpp"
+#include "span.hpp"
+#include "vector.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+
+void TestForEachTransform() {
+    std::cout << "Testing for_each and transform..." << std::endl;
+    sjtu::parallel::thread_pool pool(4);
+    sjtu::vector<long long> v(100000);
+    for (size_t i = 0; i < v.size(); ++i) {
+        v[i] = i;
+    }
+    sjtu::parallel::for_each(v, [](long long &x) { x = x * 3 + 1; }, pool);
+    std::cout << v[0] << " " << v[99999] << std::endl;
+    sjtu::vector<int> out(v.size());
+    sjtu::parallel::transform(v, out, [](long long x) { return int(x % 7); }, pool);
+    long long check = 0;
+    for (size_t i = 0; i < out.size(); ++i) {
+        check += out[i] == int((i * 3 + 1) % 7);
+    }
+    std::cout << check << std::endl;
+
+    // Only the middle of the vector, through a span.
+    sjtu::span<long long> middle = sjtu::span<long long>(v).subspan(10, 5);
+    sjtu::parallel::for_each(middle, [](long long &x) { x = -x; }, pool);
+    std::cout << v[9] << " " << v[10] << " " << v[14] << " " << v[15] << std::endl;
+
+    sjtu::vector<int> small(10);
+    try {
+        sjtu::parallel::transform(v, small, [](long long x) { return int(x); }, pool);
+    } catch (...) {
+        std::cout << "short output threw" << std::endl;
+    }
+
+    sjtu::vector<long long> empty;
+    sjtu::parallel::for_each(empty, [](long long &x) { x = 0; }, pool);
+    std::cout << sjtu::parallel::reduce(empty, 42LL, std::plus<>(), pool) << std::endl;
+}
+
+void TestReduce() {
+    std::cout << "Testing reduce..." << std::endl;
+    sjtu::vector<long long> v(1000000);
+    for (size_t i = 0; i < v.size(); ++i) {
+        v[i] = i;
+    }
+    std::cout << sjtu::parallel::reduce(v, 0LL) << std::endl;
+    std::cout << sjtu::parallel::transform_reduce(
+                     v, 0LL, std::plus<>(), [](long long x) { return x % 3; })
+              << std::endl;
+
+    // Floating point sums come out bit-identical on any pool.
+    sjtu::vector<double> d(777777);
+    for (size_t i = 0; i < d.size(); ++i) {
+        d[i] = 1.0 / (i + 1) * (i % 2 ? -1e8 : 1e8);
+    }
+    double reference = 0;
+    bool same = true;
+    for (size_t threads = 1; threads <= 8; ++threads) {
+        sjtu::parallel::thread_pool pool(threads);
+        for (int rep = 0; rep < 5; ++rep) {
+            double sum = sjtu::parallel::reduce(d, 0.0, std::plus<>(), pool);
+            if (threads == 1 && rep == 0) {
+                reference = sum;
+            }
+            same = same && std::memcmp(&sum, &reference, sizeof sum) == 0;
+        }
+    }
+    std::cout << same << std::endl;
+
+    // A non-commutative operation keeps its order.
+    sjtu::vector<std::string> words(5000);
+    for (size_t i = 0; i < words.size(); ++i) {
+        words[i] = std::string(1, char('a' + i % 26));
+    }
+    sjtu::parallel::thread_pool pool(3);
+    std::string joined = sjtu::parallel::reduce(words, std::string(">"), std::plus<>(), pool);
+    std::string expected = ">";
+    for (size_t i = 0; i < words.size(); ++i) {
+        expected += words[i];
+    }
+    std::cout << joined.size() << " " << (joined == expected) << std::endl;
+}
+
+void TestExceptionsAndNesting() {
+    std::cout << "Testing exceptions and nested calls..." << std::endl;
+    sjtu::parallel::thread_pool pool(4);
+    sjtu::vector<int> v(200000, 1);
+    v[150000] = 2;
+    try {
+        sjtu::parallel::for_each(v, [](int &x) {
+            if (x == 2) {
+                throw std::string("found two");
+            }
+        }, pool);
+    } catch (const std::string &what) {
+        std::cout << what << std::endl;
+    }
+    // The pool is still usable afterwards, and a job started from inside
+    // a task runs serially instead of deadlocking.
+    sjtu::vector<sjtu::vector<int>> rows(64, sjtu::vector<int>(1000, 1));
+    sjtu::vector<long long> sums(rows.size());
+    sjtu::parallel::transform(rows, sums, [&pool](const sjtu::vector<int> &row) {
+        return sjtu::parallel::reduce(row, 0LL, std::plus<>(), pool);
+    }, pool);
+    std::cout << sjtu::parallel::reduce(sums, 0LL, std::plus<>(), pool) << std::endl;
+}
+
+int main() {
+    TestForEachTransform();
+    TestReduce();
+    TestExceptionsAndNesting();
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include "concurrent_vector.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+
+void TestSingleThread() {
+    std::cout << "Testing single-threaded use..." << std::endl;
+    sjtu::concurrent_vector<int> v;
+    std::cout << v.size() << " " << v.empty() << " " << v.capacity() << std::endl;
+    for (int i = 0; i < 100; ++i) {
+        if (v.push_back(i * i) != size_t(i)) {
+            std::cout << "wrong index " << i << std::endl;
+        }
+    }
+    std::cout << v.size() << " " << v[0] << " " << v[99] << " " << v.at(50) << std::endl;
+    // Segments hold 8, 16, 32, 64, ... slots.
+    std::cout << v.capacity() << std::endl;
+    std::cout << v.grow_by(5, 7) << " " << v.size() << " " << v[104] << std::endl;
+    std::cout << v.grow_by(0) << " " << v.size() << std::endl;
+    try {
+        v.at(105);
+    } catch (...) {
+        std::cout << "at(105) threw" << std::endl;
+    }
+    v.clear();
+    std::cout << v.size() << " " << v.capacity() << std::endl;
+    v.reserve(1000);
+    std::cout << v.capacity() << std::endl;
+}
+
+void TestStableReferences() {
+    std::cout << "Testing stable references..." << std::endl;
+    sjtu::concurrent_vector<std::string> v;
+    v.push_back("first");
+    std::string &first = v[0];
+    const std::string *where = &first;
+    for (int i = 1; i < 10000; ++i) {
+        v.emplace_back(std::to_string(i));
+    }
+    std::cout << (&v[0] == where) << " " << first << " " << v[9999] << std::endl;
+}
+
+void TestConcurrentAppend() {
+    std::cout << "Testing concurrent appends..." << std::endl;
+    const int threads = 8, per_thread = 20000;
+    sjtu::concurrent_vector<long long> v;
+    sjtu::vector<sjtu::vector<size_t>> claimed(threads);
+    sjtu::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&v, &claimed, t] {
+            for (int i = 0; i < per_thread; ++i) {
+                long long value = (long long)t * per_thread + i;
+                size_t at;
+                if (i % 100 == 0) {
+                    at = v.grow_by(3, value);
+                } else {
+                    at = v.push_back(value);
+                }
+                // Our own elements are readable as soon as the append returns.
+                if (v[at] != value) {
+                    std::cout << "read-back mismatch" << std::endl;
+                }
+                claimed[t].push_back(at);
+            }
+        });
+    }
+    for (auto &th : pool) {
+        th.join();
+    }
+    size_t expected = (size_t)threads * (per_thread + per_thread / 100 * 2);
+    std::cout << (v.size() == expected) << std::endl;
+
+    // Every value appears as many times as it was appended, at the index
+    // the append returned.
+    bool consistent = true;
+    sjtu::vector<char> seen(v.size(), 0);
+    for (int t = 0; t < threads; ++t) {
+        for (int i = 0; i < per_thread; ++i) {
+            size_t at = claimed[t][i];
+            long long value = (long long)t * per_thread + i;
+            int copies = i % 100 == 0 ? 3 : 1;
+            for (int c = 0; c < copies; ++c) {
+                if (v[at + c] != value || seen[at + c]) {
+                    consistent = false;
+                }
+                seen[at + c] = 1;
+            }
+        }
+    }
+    std::cout << consistent << " "
+              << (std::count(seen.begin(), seen.end(), 1) == (long)v.size()) << std::endl;
+}
+
+int main() {
+    TestSingleThread();
+    TestStableReferences();
+    TestConcurrentAppend();
+    return 0;
+}
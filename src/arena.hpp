@@ -0,0 +1,170 @@
+#ifndef SJTU_ARENA_HPP
+#define SJTU_ARENA_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace sjtu {
+
+// A monotonic arena: memory is bumped out of a chain of blocks, each at
+// least twice the size of the previous one, and is only returned all at
+// once by reset() or the destructor. The one exception is the most recent
+// allocation, which can be freed or grown in place; that is exactly the
+// pattern of a vector regrowing, so a lone vector in an arena keeps
+// extending the same run of memory.
+class arena {
+ private:
+  struct block {
+    block *next;
+    size_t size;
+  };
+
+  block *head_ = nullptr;
+  char *cur_ = nullptr;
+  char *end_ = nullptr;
+  char *last_ = nullptr;
+  size_t next_size_;
+  size_t blocks_ = 0;
+
+  static char *payload(block *b) { return reinterpret_cast<char *>(b + 1); }
+
+  static char *align_up(char *p, size_t align) {
+    size_t mis = reinterpret_cast<size_t>(p) & (align - 1);
+    return mis ? p + (align - mis) : p;
+  }
+
+  void add_block(size_t min_bytes) {
+    size_t size = next_size_;
+    while (size < min_bytes) size <<= 1;
+    block *b = static_cast<block *>(std::malloc(sizeof(block) + size));
+    if (b == nullptr) throw std::bad_alloc();
+    b->next = head_;
+    b->size = size;
+    head_ = b;
+    cur_ = payload(b);
+    end_ = cur_ + size;
+    next_size_ = size * 2;
+    ++blocks_;
+  }
+
+ public:
+  explicit arena(size_t initial_block = 64 * 1024)
+      : next_size_(initial_block ? initial_block : 1) {}
+  arena(const arena &) = delete;
+  arena &operator=(const arena &) = delete;
+  ~arena() {
+    while (head_) {
+      block *next = head_->next;
+      std::free(head_);
+      head_ = next;
+    }
+  }
+
+  void *allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+    char *p = cur_ ? align_up(cur_, align) : nullptr;
+    if (p == nullptr || bytes > static_cast<size_t>(end_ - p)) {
+      add_block(bytes + align);
+      p = align_up(cur_, align);
+    }
+    cur_ = p + bytes;
+    last_ = p;
+    return p;
+  }
+
+  // Only the most recent allocation is actually given back.
+  void deallocate(void *p, size_t) {
+    if (p != nullptr && p == last_) {
+      cur_ = last_;
+      last_ = nullptr;
+    }
+  }
+
+  // Extends the most recent allocation in place when the block has room,
+  // otherwise moves the first min(old_bytes, bytes) bytes to a fresh one.
+  void *reallocate(void *p, size_t old_bytes, size_t bytes,
+                   size_t align = alignof(std::max_align_t)) {
+    if (p != nullptr && p == last_ &&
+        bytes <= static_cast<size_t>(end_ - last_)) {
+      cur_ = last_ + bytes;
+      return p;
+    }
+    void *np = allocate(bytes, align);
+    if (p != nullptr) {
+      std::memcpy(np, p, old_bytes < bytes ? old_bytes : bytes);
+    }
+    return np;
+  }
+
+  // Releases everything allocated so far. The newest block, the largest
+  // one, is kept, so a steady request loop stops touching the heap.
+  void reset() {
+    if (head_ == nullptr) return;
+    block *keep = head_;
+    block *b = keep->next;
+    while (b) {
+      block *next = b->next;
+      std::free(b);
+      b = next;
+    }
+    keep->next = nullptr;
+    blocks_ = 1;
+    cur_ = payload(keep);
+    end_ = cur_ + keep->size;
+    last_ = nullptr;
+  }
+
+  size_t block_count() const { return blocks_; }
+  size_t bytes_reserved() const {
+    size_t total = 0;
+    for (block *b = head_; b; b = b->next) total += b->size;
+    return total;
+  }
+};
+
+// Adapts an arena to the allocator requirements so that
+// sjtu::vector<T, arena_allocator<T>> draws its storage from it. Copies
+// share the arena and compare equal exactly when they share it.
+template <typename T>
+class arena_allocator {
+ private:
+  arena *arena_;
+
+  template <typename U>
+  friend class arena_allocator;
+
+ public:
+  using value_type = T;
+
+  explicit arena_allocator(arena &a) noexcept : arena_(&a) {}
+  template <typename U>
+  arena_allocator(const arena_allocator<U> &other) noexcept
+      : arena_(other.arena_) {}
+
+  T *allocate(size_t n) {
+    return static_cast<T *>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T *p, size_t n) noexcept {
+    arena_->deallocate(p, n * sizeof(T));
+  }
+  T *reallocate(T *p, size_t old_n, size_t n) {
+    return static_cast<T *>(
+        arena_->reallocate(p, old_n * sizeof(T), n * sizeof(T), alignof(T)));
+  }
+
+  arena &resource() const noexcept { return *arena_; }
+
+  template <typename U>
+  bool operator==(const arena_allocator<U> &rhs) const noexcept {
+    return arena_ == rhs.arena_;
+  }
+  template <typename U>
+  bool operator!=(const arena_allocator<U> &rhs) const noexcept {
+    return arena_ != rhs.arena_;
+  }
+};
+
+}  // namespace sjtu
+
+#endif
@@ -0,0 +1,200 @@
+#ifndef SJTU_CONCURRENT_VECTOR_HPP
+#define SJTU_CONCURRENT_VECTOR_HPP
+
+#include "vector.hpp"
+
+#include <atomic>
+
+namespace sjtu {
+
+// A growable sequence that any number of threads may append to and read
+// from at once. Elements live in segments of 2^first_segment_bits,
+// 2^(first_segment_bits + 1), ... slots that are allocated on demand and
+// never moved, so references and pointers stay valid until the container
+// is destroyed. Appends claim their slots with one compare-and-swap and
+// return the index of the first one; indexed reads are wait-free.
+//
+// size() counts claimed slots. An element may be read once the append
+// that created it has returned, in that thread or in one that has
+// synchronized with it (for example by joining it). clear() and the
+// destructor are not thread-safe.
+//
+// T must be nothrow move constructible: values are built before their
+// slots are claimed and then moved in, so a throwing constructor or a
+// failed segment allocation claims nothing.
+template <typename T>
+class concurrent_vector {
+  static_assert(std::is_nothrow_move_constructible<T>::value,
+                "concurrent_vector requires a nothrow move constructor");
+
+ private:
+  static constexpr size_t first_segment_bits = 3;
+  static constexpr size_t max_segments = 64 - first_segment_bits;
+  static constexpr bool over_aligned =
+      alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+  std::atomic<T *> segments_[max_segments];
+  std::atomic<size_t> size_{0};
+
+  static size_t segment_of(size_t i) {
+    return 63 - __builtin_clzll((i >> first_segment_bits) + 1);
+  }
+  static size_t segment_base(size_t k) {
+    return ((size_t(1) << k) - 1) << first_segment_bits;
+  }
+  static size_t segment_size(size_t k) {
+    return size_t(1) << (first_segment_bits + k);
+  }
+
+  static T *allocate_segment(size_t k) {
+    size_t bytes = segment_size(k) * sizeof(T);
+    if constexpr (over_aligned) {
+      return static_cast<T *>(
+          ::operator new(bytes, std::align_val_t(alignof(T))));
+    } else {
+      return static_cast<T *>(::operator new(bytes));
+    }
+  }
+  static void free_segment(T *p) {
+    if constexpr (over_aligned) {
+      ::operator delete(p, std::align_val_t(alignof(T)));
+    } else {
+      ::operator delete(p);
+    }
+  }
+
+  // Returns segment k, allocating it if no thread has yet. Racing
+  // allocators agree through a compare-and-swap; the losers free theirs.
+  T *segment(size_t k) {
+    T *seg = segments_[k].load(std::memory_order_acquire);
+    if (seg != nullptr) return seg;
+    T *fresh = allocate_segment(k);
+    if (segments_[k].compare_exchange_strong(seg, fresh,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_acquire)) {
+      return fresh;
+    }
+    free_segment(fresh);
+    return seg;
+  }
+
+  T *slot(size_t i) const {
+    size_t k = segment_of(i);
+    T *seg = segments_[k].load(std::memory_order_acquire);
+    return seg + (i - segment_base(k));
+  }
+
+  // Claims n consecutive slots and returns the first. The segments they
+  // fall in are allocated before the claim is published.
+  size_t claim(size_t n) {
+    size_t first = size_.load(std::memory_order_relaxed);
+    if (n == 0) return first;
+    for (;;) {
+      size_t last = segment_of(first + n - 1);
+      for (size_t k = segment_of(first); k <= last; ++k) segment(k);
+      if (size_.compare_exchange_weak(first, first + n,
+                                      std::memory_order_relaxed)) {
+        return first;
+      }
+    }
+  }
+
+  void destroy_all() {
+    size_t n = size_.load(std::memory_order_relaxed);
+    for (size_t k = 0; k < max_segments; ++k) {
+      T *seg = segments_[k].load(std::memory_order_relaxed);
+      if (seg == nullptr) break;
+      size_t base = segment_base(k);
+      for (size_t j = 0; j < segment_size(k) && base + j < n; ++j) {
+        seg[j].~T();
+      }
+    }
+    size_.store(0, std::memory_order_relaxed);
+  }
+
+ public:
+  concurrent_vector() {
+    for (size_t k = 0; k < max_segments; ++k) {
+      segments_[k].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+  concurrent_vector(const concurrent_vector &) = delete;
+  concurrent_vector &operator=(const concurrent_vector &) = delete;
+  ~concurrent_vector() {
+    destroy_all();
+    for (size_t k = 0; k < max_segments; ++k) {
+      T *seg = segments_[k].load(std::memory_order_relaxed);
+      if (seg != nullptr) free_segment(seg);
+    }
+  }
+
+  template <typename... Args>
+  size_t emplace_back(Args &&...args) {
+    if constexpr (std::is_nothrow_constructible<T, Args &&...>::value) {
+      size_t i = claim(1);
+      new (slot(i)) T(std::forward<Args>(args)...);
+      return i;
+    } else {
+      T value(std::forward<Args>(args)...);
+      size_t i = claim(1);
+      new (slot(i)) T(std::move(value));
+      return i;
+    }
+  }
+
+  size_t push_back(const T &value) { return emplace_back(value); }
+  size_t push_back(T &&value) { return emplace_back(std::move(value)); }
+
+  // Appends n copies of value as one contiguous run of indices and
+  // returns the first. The copies are made after the claim, so they must
+  // not throw.
+  size_t grow_by(size_t n, const T &value) {
+    static_assert(std::is_nothrow_copy_constructible<T>::value,
+                  "grow_by needs a T whose copy cannot throw");
+    size_t first = claim(n);
+    for (size_t i = first; i < first + n; ++i) new (slot(i)) T(value);
+    return first;
+  }
+  size_t grow_by(size_t n) { return grow_by(n, T()); }
+
+  // Allocates the segments for the first n slots up front.
+  void reserve(size_t n) {
+    if (n == 0) return;
+    for (size_t k = 0, last = segment_of(n - 1); k <= last; ++k) segment(k);
+  }
+
+  T &operator[](size_t pos) {
+    detail::check_subscript(pos, size());
+    return *slot(pos);
+  }
+  const T &operator[](size_t pos) const {
+    detail::check_subscript(pos, size());
+    return *slot(pos);
+  }
+  T &at(size_t pos) {
+    if (pos >= size()) throw index_out_of_bound();
+    return *slot(pos);
+  }
+  const T &at(size_t pos) const {
+    if (pos >= size()) throw index_out_of_bound();
+    return *slot(pos);
+  }
+
+  size_t size() const { return size_.load(std::memory_order_relaxed); }
+  bool empty() const { return size() == 0; }
+  size_t capacity() const {
+    size_t cap = 0;
+    for (size_t k = 0; k < max_segments; ++k) {
+      if (segments_[k].load(std::memory_order_acquire) == nullptr) break;
+      cap += segment_size(k);
+    }
+    return cap;
+  }
+
+  // Destroys the elements but keeps the segments for reuse.
+  void clear() { destroy_all(); }
+};
+
+}  // namespace sjtu
+
+#endif
@@ -0,0 +1,325 @@
+#ifndef SJTU_DEVECTOR_HPP
+#define SJTU_DEVECTOR_HPP
+
+#include "vector.hpp"
+
+namespace sjtu {
+
+// A vector with spare capacity at both ends: the elements occupy
+// data_[off_, off_ + sz_) of a cap_-slot buffer, so push_front and
+// pop_front are amortized O(1) while storage stays contiguous.
+template <typename T>
+class devector {
+ private:
+  T *data_ = nullptr;
+  size_t off_ = 0;
+  size_t sz_ = 0;
+  size_t cap_ = 0;
+
+  static constexpr bool trivially_relocatable =
+      std::is_trivially_copyable<T>::value;
+  static constexpr bool nothrow_relocatable =
+      trivially_relocatable || std::is_nothrow_move_constructible<T>::value;
+
+  static constexpr bool over_aligned =
+      alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+  static T *raw_alloc(size_t n) {
+    if constexpr (over_aligned) {
+      return static_cast<T *>(
+          ::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    } else {
+      return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+  }
+  static void raw_free(T *p) {
+    if constexpr (over_aligned) {
+      ::operator delete(p, std::align_val_t(alignof(T)));
+    } else {
+      ::operator delete(p);
+    }
+  }
+
+  T *first() const { return data_ + off_; }
+
+  template <typename, typename>
+  friend class detail::contiguous_iterator;
+
+  bool holds(const T *p) const { return p >= first() && p < first() + sz_; }
+
+  template <typename It>
+  size_t index_of(const It &pos) const {
+    if (!pos.belongs_to(this) || pos.ptr_ < first() ||
+        pos.ptr_ > first() + sz_) {
+      throw invalid_iterator();
+    }
+    return pos.ptr_ - first();
+  }
+
+  // Moves the elements into a fresh buffer of ncap slots starting at noff,
+  // copying instead when T's move may throw so a failure changes nothing.
+  void reallocate(size_t ncap, size_t noff) {
+    T *nd = raw_alloc(ncap);
+    T *src = first();
+    size_t i = 0;
+    try {
+      for (; i < sz_; ++i) new (nd + noff + i) T(std::move_if_noexcept(src[i]));
+    } catch (...) {
+      for (size_t j = 0; j < i; ++j) nd[noff + j].~T();
+      raw_free(nd);
+      throw;
+    }
+    for (size_t j = 0; j < sz_; ++j) src[j].~T();
+    raw_free(data_);
+    data_ = nd;
+    off_ = noff;
+    cap_ = ncap;
+  }
+
+  // Slides the elements within the current buffer so they start at noff.
+  // Requires a relocation that cannot throw.
+  void recenter(size_t noff) {
+    T *src = first();
+    T *dst = data_ + noff;
+    if constexpr (trivially_relocatable) {
+      std::memmove(dst, src, sz_ * sizeof(T));
+    } else if (noff < off_) {
+      for (size_t i = 0; i < sz_; ++i) {
+        new (dst + i) T(std::move(src[i]));
+        src[i].~T();
+      }
+    } else {
+      for (size_t i = sz_; i-- > 0;) {
+        new (dst + i) T(std::move(src[i]));
+        src[i].~T();
+      }
+    }
+    off_ = noff;
+  }
+
+  // Guarantees a free slot before the first element (at_front) or after
+  // the last. Slack is split evenly between both ends afterwards, and the
+  // buffer only grows when less than half of size() is free, which keeps
+  // alternating front/back traffic amortized O(1).
+  void make_room(bool at_front) {
+    if (at_front ? off_ > 0 : off_ + sz_ < cap_) return;
+    size_t free = cap_ - sz_;
+    if (nothrow_relocatable && free >= 2 && free >= sz_ / 2) {
+      recenter(free / 2);
+      return;
+    }
+    size_t ncap = cap_ ? cap_ * 2 : 8;
+    while (ncap - sz_ < 2) ncap <<= 1;
+    reallocate(ncap, (ncap - sz_) / 2);
+  }
+
+ public:
+  using iterator = detail::contiguous_iterator<devector, T>;
+  using const_iterator = detail::contiguous_iterator<devector, const T>;
+
+  devector() = default;
+  devector(const devector &other) {
+    if (other.sz_) {
+      data_ = raw_alloc(other.sz_);
+      cap_ = other.sz_;
+      size_t i = 0;
+      try {
+        for (; i < other.sz_; ++i) new (data_ + i) T(other.first()[i]);
+      } catch (...) {
+        for (size_t j = 0; j < i; ++j) data_[j].~T();
+        raw_free(data_);
+        data_ = nullptr;
+        cap_ = 0;
+        throw;
+      }
+      sz_ = other.sz_;
+    }
+  }
+  devector(devector &&other) noexcept
+      : data_(other.data_), off_(other.off_), sz_(other.sz_), cap_(other.cap_) {
+    other.data_ = nullptr;
+    other.off_ = other.sz_ = other.cap_ = 0;
+  }
+  ~devector() {
+    clear();
+    if (data_) raw_free(data_);
+  }
+  devector &operator=(const devector &other) {
+    if (this == &other) return *this;
+    devector tmp(other);
+    swap(tmp);
+    return *this;
+  }
+  devector &operator=(devector &&other) noexcept {
+    if (this == &other) return *this;
+    devector tmp(std::move(other));
+    swap(tmp);
+    return *this;
+  }
+
+  void swap(devector &rhs) noexcept {
+    std::swap(data_, rhs.data_);
+    std::swap(off_, rhs.off_);
+    std::swap(sz_, rhs.sz_);
+    std::swap(cap_, rhs.cap_);
+  }
+
+  T &at(const size_t &pos) {
+    if (pos >= sz_) throw index_out_of_bound();
+    return first()[pos];
+  }
+  const T &at(const size_t &pos) const {
+    if (pos >= sz_) throw index_out_of_bound();
+    return first()[pos];
+  }
+
+  T &operator[](const size_t &pos) {
+    detail::check_subscript(pos, sz_);
+    return first()[pos];
+  }
+  const T &operator[](const size_t &pos) const {
+    detail::check_subscript(pos, sz_);
+    return first()[pos];
+  }
+
+  const T &front() const {
+    if (sz_ == 0) throw container_is_empty();
+    return first()[0];
+  }
+  const T &back() const {
+    if (sz_ == 0) throw container_is_empty();
+    return first()[sz_ - 1];
+  }
+
+  T *data() { return first(); }
+  const T *data() const { return first(); }
+
+  iterator begin() { return iterator(first(), this); }
+  const_iterator begin() const { return const_iterator(first(), this); }
+  const_iterator cbegin() const { return const_iterator(first(), this); }
+
+  iterator end() { return iterator(first() + sz_, this); }
+  const_iterator end() const { return const_iterator(first() + sz_, this); }
+  const_iterator cend() const { return const_iterator(first() + sz_, this); }
+
+  bool empty() const { return sz_ == 0; }
+  size_t size() const { return sz_; }
+  size_t capacity() const { return cap_; }
+  // Free slots before the first element and after the last one.
+  size_t front_free() const { return off_; }
+  size_t back_free() const { return cap_ - off_ - sz_; }
+
+  void clear() {
+    T *p = first();
+    for (size_t i = 0; i < sz_; ++i) p[i].~T();
+    sz_ = 0;
+    off_ = cap_ / 2;
+  }
+
+  template <typename... Args>
+  T &emplace_back(Args &&...args) {
+    if (off_ + sz_ == cap_) {
+      T value(std::forward<Args>(args)...);
+      make_room(false);
+      new (first() + sz_) T(std::move(value));
+    } else {
+      new (first() + sz_) T(std::forward<Args>(args)...);
+    }
+    return first()[sz_++];
+  }
+
+  template <typename... Args>
+  T &emplace_front(Args &&...args) {
+    if (off_ == 0) {
+      T value(std::forward<Args>(args)...);
+      make_room(true);
+      new (first() - 1) T(std::move(value));
+    } else {
+      new (first() - 1) T(std::forward<Args>(args)...);
+    }
+    --off_;
+    ++sz_;
+    return first()[0];
+  }
+
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+  void push_front(const T &value) { emplace_front(value); }
+  void push_front(T &&value) { emplace_front(std::move(value)); }
+
+  void pop_back() {
+    if (sz_ == 0) throw container_is_empty();
+    --sz_;
+    first()[sz_].~T();
+  }
+
+  void pop_front() {
+    if (sz_ == 0) throw container_is_empty();
+    first()[0].~T();
+    ++off_;
+    --sz_;
+  }
+
+  iterator insert(iterator pos, const T &value) {
+    return insert(index_of(pos), value);
+  }
+
+  iterator insert(iterator pos, T &&value) {
+    return insert(index_of(pos), std::move(value));
+  }
+
+  iterator insert(const size_t &ind, const T &value) {
+    if (ind > sz_) throw index_out_of_bound();
+    T tmp(value);
+    return insert(ind, std::move(tmp));
+  }
+
+  // Shifts whichever side of ind is shorter.
+  iterator insert(const size_t &ind, T &&value) {
+    if (ind > sz_) throw index_out_of_bound();
+    if (ind == 0) {
+      emplace_front(std::move(value));
+    } else if (ind == sz_) {
+      emplace_back(std::move(value));
+    } else if (ind < sz_ / 2) {
+      make_room(true);
+      T *p = first();
+      new (p - 1) T(std::move(p[0]));
+      --off_;
+      ++sz_;
+      for (size_t i = 0; i + 1 < ind; ++i) p[i] = std::move(p[i + 1]);
+      p[ind - 1] = std::move(value);
+    } else {
+      make_room(false);
+      T *p = first();
+      new (p + sz_) T(std::move(p[sz_ - 1]));
+      ++sz_;
+      for (size_t i = sz_ - 2; i > ind; --i) p[i] = std::move(p[i - 1]);
+      p[ind] = std::move(value);
+    }
+    return iterator(first() + ind, this);
+  }
+
+  iterator erase(iterator pos) {
+    size_t ind = index_of(pos);
+    if (ind == sz_) throw invalid_iterator();
+    T *p = first();
+    if (ind < sz_ / 2) {
+      for (size_t i = ind; i > 0; --i) p[i] = std::move(p[i - 1]);
+      pop_front();
+    } else {
+      for (size_t i = ind; i + 1 < sz_; ++i) p[i] = std::move(p[i + 1]);
+      pop_back();
+    }
+    return iterator(first() + ind, this);
+  }
+
+  iterator erase(const size_t &ind) {
+    if (ind >= sz_) throw index_out_of_bound();
+    return erase(iterator(first() + ind, this));
+  }
+};
+
+}  // namespace sjtu
+
+#endif
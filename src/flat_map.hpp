@@ -0,0 +1,481 @@
+#ifndef SJTU_FLAT_MAP_HPP
+#define SJTU_FLAT_MAP_HPP
+
+#include "vector.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+namespace sjtu {
+
+namespace detail {
+
+// Index of the first element of base[0, n) not less than key. The loop
+// has no data-dependent branch: the step is picked with a conditional
+// move, so lookups do not stall on mispredictions.
+template <typename K, typename Key, typename Compare>
+size_t lower_bound_index(const K *base, size_t n, const Key &key,
+                         const Compare &comp) {
+  if (n == 0) return 0;
+  const K *p = base;
+  while (n > 1) {
+    size_t half = n / 2;
+    p = comp(p[half], key) ? p + half : p;
+    n -= half;
+  }
+  return (p - base) + comp(*p, key);
+}
+
+// Index of the first element of base[0, n) greater than key.
+template <typename K, typename Key, typename Compare>
+size_t upper_bound_index(const K *base, size_t n, const Key &key,
+                         const Compare &comp) {
+  if (n == 0) return 0;
+  const K *p = base;
+  while (n > 1) {
+    size_t half = n / 2;
+    p = comp(key, p[half]) ? p : p + half;
+    n -= half;
+  }
+  return (p - base) + !comp(key, *p);
+}
+
+// The positions that sort keys stably, keeping only the first of each run
+// of equivalent keys.
+template <typename K, typename Compare>
+vector<size_t> sorted_unique_order(const vector<K> &keys,
+                                   const Compare &comp) {
+  vector<size_t> order(keys.size());
+  std::iota(order.data(), order.data() + order.size(), size_t(0));
+  const K *k = keys.data();
+  std::stable_sort(order.data(), order.data() + order.size(),
+                   [&](size_t a, size_t b) { return comp(k[a], k[b]); });
+  size_t kept = 0;
+  for (size_t i = 0; i < order.size(); ++i) {
+    if (kept == 0 || comp(k[order[kept - 1]], k[order[i]])) {
+      order[kept++] = order[i];
+    }
+  }
+  order.resize(kept);
+  return order;
+}
+
+}  // namespace detail
+
+// A sorted set of unique keys stored contiguously in a sjtu::vector.
+// Lookups are branchless binary searches; single inserts and erases shift
+// the tail like vector::insert, while insert_range sorts the batch and
+// merges it in one pass. Iterators are the vector's const_iterators and
+// are invalidated by any modification.
+template <typename K, typename Compare = std::less<K>>
+class flat_set {
+ private:
+  vector<K> keys_;
+  Compare comp_;
+
+  bool equivalent(const K &a, const K &b) const {
+    return !comp_(a, b) && !comp_(b, a);
+  }
+
+  // Sorts add, drops duplicates and keys already present, and merges the
+  // rest in one pass; appends when it all sorts after the last key. The
+  // merge copies the set's own keys when their moves may throw and swaps
+  // the result in at the end, so a failure leaves the set as it was.
+  void merge(vector<K> &add) {
+    vector<size_t> order = detail::sorted_unique_order(add, comp_);
+    size_t m = order.size(), n = keys_.size();
+    if (m == 0) return;
+    if (n == 0 || comp_(keys_[n - 1], add[order[0]])) {
+      keys_.reserve(n + m);
+      for (size_t j = 0; j < m; ++j) keys_.push_back(std::move(add[order[j]]));
+      return;
+    }
+    vector<K> out;
+    out.reserve(n + m);
+    size_t i = 0, j = 0;
+    while (i < n && j < m) {
+      K &k = add[order[j]];
+      if (comp_(k, keys_[i])) {
+        out.push_back(std::move(k));
+        ++j;
+      } else {
+        if (!comp_(keys_[i], k)) ++j;
+        out.push_back(std::move_if_noexcept(keys_[i++]));
+      }
+    }
+    for (; i < n; ++i) out.push_back(std::move_if_noexcept(keys_[i]));
+    for (; j < m; ++j) out.push_back(std::move(add[order[j]]));
+    keys_.swap(out);
+  }
+
+ public:
+  using key_type = K;
+  using value_type = K;
+  using iterator = typename vector<K>::const_iterator;
+  using const_iterator = iterator;
+
+  flat_set() = default;
+  explicit flat_set(const Compare &comp) : comp_(comp) {}
+  // Bulk construction: one sort and one pass to drop duplicates.
+  explicit flat_set(vector<K> keys, const Compare &comp = Compare())
+      : comp_(comp) {
+    merge(keys);
+  }
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::value_type>
+  flat_set(InputIt first, InputIt last, const Compare &comp = Compare())
+      : flat_set(vector<K>(first, last), comp) {}
+  flat_set(std::initializer_list<K> il, const Compare &comp = Compare())
+      : flat_set(vector<K>(il), comp) {}
+
+  iterator begin() const { return keys_.begin(); }
+  iterator end() const { return keys_.end(); }
+  const vector<K> &keys() const { return keys_; }
+
+  bool empty() const { return keys_.empty(); }
+  size_t size() const { return keys_.size(); }
+  void reserve(size_t n) { keys_.reserve(n); }
+  void clear() { keys_.clear(); }
+
+  iterator lower_bound(const K &key) const {
+    return begin() +
+           detail::lower_bound_index(keys_.data(), keys_.size(), key, comp_);
+  }
+  iterator upper_bound(const K &key) const {
+    return begin() +
+           detail::upper_bound_index(keys_.data(), keys_.size(), key, comp_);
+  }
+  iterator find(const K &key) const {
+    iterator it = lower_bound(key);
+    return it != end() && !comp_(key, *it) ? it : end();
+  }
+  bool contains(const K &key) const { return find(key) != end(); }
+  size_t count(const K &key) const { return contains(key); }
+
+  std::pair<iterator, bool> insert(const K &key) {
+    K tmp(key);
+    return insert(std::move(tmp));
+  }
+  std::pair<iterator, bool> insert(K &&key) {
+    size_t i =
+        detail::lower_bound_index(keys_.data(), keys_.size(), key, comp_);
+    if (i < keys_.size() && equivalent(keys_[i], key)) {
+      return {begin() + i, false};
+    }
+    keys_.insert(i, std::move(key));
+    return {begin() + i, true};
+  }
+
+  // Inserts a batch in O(size() + k log k) rather than k tail shifts.
+  template <typename InputIt>
+  void insert_range(InputIt first, InputIt last) {
+    vector<K> add(first, last);
+    merge(add);
+  }
+  void insert_range(std::initializer_list<K> il) {
+    insert_range(il.begin(), il.end());
+  }
+
+  size_t erase(const K &key) {
+    iterator it = find(key);
+    if (it == end()) return 0;
+    erase(it);
+    return 1;
+  }
+  iterator erase(iterator pos) {
+    size_t i = pos - begin();
+    if (i >= keys_.size()) throw invalid_iterator();
+    keys_.erase(i);
+    return begin() + i;
+  }
+};
+
+// A sorted map with unique keys. Keys and values live in two parallel
+// sjtu::vectors, so a lookup only touches the keys. Dereferencing an
+// iterator gives a pair of references (first: const K&, second: V&).
+// Inserting and erasing invalidate iterators and references.
+template <typename K, typename V, typename Compare = std::less<K>>
+class flat_map {
+ private:
+  vector<K> keys_;
+  vector<V> values_;
+  Compare comp_;
+
+  size_t lower_index(const K &key) const {
+    return detail::lower_bound_index(keys_.data(), keys_.size(), key, comp_);
+  }
+  size_t find_index(const K &key) const {
+    size_t i = lower_index(key);
+    return i < keys_.size() && !comp_(key, keys_[i]) ? i : keys_.size();
+  }
+
+  // Sorts the batch, keeping the first value for each key and skipping
+  // keys already present, and merges it in one pass. Both outputs are
+  // reserved up front, so only an element's move can throw; the batch is
+  // then lost, but keys_ and values_ still match: appending trims both
+  // back, and merging builds fresh vectors, copying the map's own
+  // elements when their moves may throw, and swaps them in at the end.
+  void merge(vector<K> &add_k, vector<V> &add_v) {
+    vector<size_t> order = detail::sorted_unique_order(add_k, comp_);
+    size_t m = order.size(), n = keys_.size();
+    if (m == 0) return;
+    if (n == 0 || comp_(keys_[n - 1], add_k[order[0]])) {
+      keys_.reserve(n + m);
+      values_.reserve(n + m);
+      try {
+        for (size_t j = 0; j < m; ++j) {
+          keys_.push_back(std::move(add_k[order[j]]));
+          values_.push_back(std::move(add_v[order[j]]));
+        }
+      } catch (...) {
+        keys_.pop_back(keys_.size() - n);
+        values_.pop_back(values_.size() - n);
+        throw;
+      }
+      return;
+    }
+    vector<K> out_k;
+    vector<V> out_v;
+    out_k.reserve(n + m);
+    out_v.reserve(n + m);
+    size_t i = 0, j = 0;
+    while (i < n && j < m) {
+      size_t a = order[j];
+      if (comp_(add_k[a], keys_[i])) {
+        out_k.push_back(std::move(add_k[a]));
+        out_v.push_back(std::move(add_v[a]));
+        ++j;
+      } else {
+        if (!comp_(keys_[i], add_k[a])) ++j;
+        out_k.push_back(std::move_if_noexcept(keys_[i]));
+        out_v.push_back(std::move_if_noexcept(values_[i]));
+        ++i;
+      }
+    }
+    for (; i < n; ++i) {
+      out_k.push_back(std::move_if_noexcept(keys_[i]));
+      out_v.push_back(std::move_if_noexcept(values_[i]));
+    }
+    for (; j < m; ++j) {
+      out_k.push_back(std::move(add_k[order[j]]));
+      out_v.push_back(std::move(add_v[order[j]]));
+    }
+    keys_.swap(out_k);
+    values_.swap(out_v);
+  }
+
+  template <bool Const>
+  class basic_iterator {
+   private:
+    using map_ptr = std::conditional_t<Const, const flat_map *, flat_map *>;
+    using mapped = std::conditional_t<Const, const V, V>;
+
+    map_ptr map_ = nullptr;
+    size_t i_ = 0;
+
+    friend class flat_map;
+    template <bool>
+    friend class basic_iterator;
+
+    basic_iterator(map_ptr m, size_t i) : map_(m), i_(i) {}
+
+   public:
+    using value_type = std::pair<const K &, mapped &>;
+    using reference = value_type;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::random_access_iterator_tag;
+
+    struct pointer {
+      value_type ref;
+      const value_type *operator->() const { return &ref; }
+    };
+
+    basic_iterator() = default;
+    // iterator converts to const_iterator.
+    template <bool C, typename = std::enable_if_t<Const && !C>>
+    basic_iterator(const basic_iterator<C> &other)
+        : map_(other.map_), i_(other.i_) {}
+
+    reference operator*() const {
+      return {map_->keys_.data()[i_], map_->values_.data()[i_]};
+    }
+    pointer operator->() const { return {**this}; }
+
+    basic_iterator &operator++() {
+      ++i_;
+      return *this;
+    }
+    basic_iterator operator++(int) { return basic_iterator(map_, i_++); }
+    basic_iterator &operator--() {
+      --i_;
+      return *this;
+    }
+    basic_iterator operator--(int) { return basic_iterator(map_, i_--); }
+    basic_iterator &operator+=(difference_type n) {
+      i_ += n;
+      return *this;
+    }
+    basic_iterator &operator-=(difference_type n) {
+      i_ -= n;
+      return *this;
+    }
+    basic_iterator operator+(difference_type n) const {
+      return basic_iterator(map_, i_ + n);
+    }
+    basic_iterator operator-(difference_type n) const {
+      return basic_iterator(map_, i_ - n);
+    }
+    friend basic_iterator operator+(difference_type n,
+                                    const basic_iterator &it) {
+      return it + n;
+    }
+    reference operator[](difference_type n) const { return *(*this + n); }
+    difference_type operator-(const basic_iterator &rhs) const {
+      return difference_type(i_) - difference_type(rhs.i_);
+    }
+    bool operator==(const basic_iterator &rhs) const {
+      return map_ == rhs.map_ && i_ == rhs.i_;
+    }
+    bool operator!=(const basic_iterator &rhs) const { return !(*this == rhs); }
+    bool operator<(const basic_iterator &rhs) const { return i_ < rhs.i_; }
+    bool operator>(const basic_iterator &rhs) const { return i_ > rhs.i_; }
+    bool operator<=(const basic_iterator &rhs) const { return i_ <= rhs.i_; }
+    bool operator>=(const basic_iterator &rhs) const { return i_ >= rhs.i_; }
+
+    // Position in keys() and values().
+    size_t index() const { return i_; }
+  };
+
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  flat_map() = default;
+  explicit flat_map(const Compare &comp) : comp_(comp) {}
+  // Bulk construction from parallel key and value vectors: one stable
+  // sort, keeping the first value given for each key.
+  flat_map(vector<K> keys, vector<V> values, const Compare &comp = Compare())
+      : comp_(comp) {
+    if (keys.size() != values.size()) throw runtime_error();
+    merge(keys, values);
+  }
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::value_type>
+  flat_map(InputIt first, InputIt last, const Compare &comp = Compare())
+      : comp_(comp) {
+    insert_range(first, last);
+  }
+  flat_map(std::initializer_list<std::pair<K, V>> il,
+           const Compare &comp = Compare())
+      : flat_map(il.begin(), il.end(), comp) {}
+
+  iterator begin() { return iterator(this, 0); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  iterator end() { return iterator(this, keys_.size()); }
+  const_iterator end() const { return const_iterator(this, keys_.size()); }
+
+  const vector<K> &keys() const { return keys_; }
+  const vector<V> &values() const { return values_; }
+
+  bool empty() const { return keys_.empty(); }
+  size_t size() const { return keys_.size(); }
+  void reserve(size_t n) {
+    keys_.reserve(n);
+    values_.reserve(n);
+  }
+  void clear() {
+    keys_.clear();
+    values_.clear();
+  }
+
+  iterator lower_bound(const K &key) {
+    return iterator(this, lower_index(key));
+  }
+  const_iterator lower_bound(const K &key) const {
+    return const_iterator(this, lower_index(key));
+  }
+  iterator find(const K &key) { return iterator(this, find_index(key)); }
+  const_iterator find(const K &key) const {
+    return const_iterator(this, find_index(key));
+  }
+  bool contains(const K &key) const { return find_index(key) != size(); }
+  size_t count(const K &key) const { return contains(key); }
+
+  V &at(const K &key) {
+    size_t i = find_index(key);
+    if (i == size()) throw index_out_of_bound();
+    return values_[i];
+  }
+  const V &at(const K &key) const {
+    size_t i = find_index(key);
+    if (i == size()) throw index_out_of_bound();
+    return values_[i];
+  }
+
+  // Inserts a value-initialized V when key is missing.
+  V &operator[](const K &key) { return try_emplace(key).first->second; }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const K &key, Args &&...args) {
+    size_t i = lower_index(key);
+    if (i < size() && !comp_(key, keys_[i])) return {iterator(this, i), false};
+    V value(std::forward<Args>(args)...);
+    keys_.insert(i, key);
+    try {
+      values_.insert(i, std::move(value));
+    } catch (...) {
+      keys_.erase(i);
+      throw;
+    }
+    return {iterator(this, i), true};
+  }
+
+  std::pair<iterator, bool> insert(const K &key, const V &value) {
+    return try_emplace(key, value);
+  }
+  std::pair<iterator, bool> insert(const std::pair<K, V> &kv) {
+    return try_emplace(kv.first, kv.second);
+  }
+  std::pair<iterator, bool> insert_or_assign(const K &key, const V &value) {
+    std::pair<iterator, bool> r = try_emplace(key, value);
+    if (!r.second) values_[r.first.index()] = value;
+    return r;
+  }
+
+  // Inserts a batch of (key, value) pairs in O(size() + k log k) rather
+  // than k tail shifts. As with insert, existing keys keep their values.
+  template <typename InputIt>
+  void insert_range(InputIt first, InputIt last) {
+    vector<K> add_k;
+    vector<V> add_v;
+    for (; first != last; ++first) {
+      add_k.push_back((*first).first);
+      add_v.push_back((*first).second);
+    }
+    merge(add_k, add_v);
+  }
+  void insert_range(std::initializer_list<std::pair<K, V>> il) {
+    insert_range(il.begin(), il.end());
+  }
+
+  size_t erase(const K &key) {
+    size_t i = find_index(key);
+    if (i == size()) return 0;
+    keys_.erase(i);
+    values_.erase(i);
+    return 1;
+  }
+  iterator erase(const_iterator pos) {
+    if (pos.map_ != this || pos.i_ >= size()) throw invalid_iterator();
+    keys_.erase(pos.i_);
+    values_.erase(pos.i_);
+    return iterator(this, pos.i_);
+  }
+};
+
+}  // namespace sjtu
+
+#endif
@@ -0,0 +1,286 @@
+#ifndef SJTU_PAGE_ALLOCATOR_HPP
+#define SJTU_PAGE_ALLOCATOR_HPP
+
+#include "vector.hpp"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+// Defining SJTU_NO_MREMAP makes the allocators below grow by copying in
+// steps even where the kernel offers mremap.
+#if defined(MREMAP_MAYMOVE) && !defined(SJTU_NO_MREMAP)
+#define SJTU_HAS_MREMAP 1
+#else
+#define SJTU_HAS_MREMAP 0
+#endif
+
+namespace sjtu {
+
+namespace detail {
+namespace pages {
+
+inline size_t page_size() {
+  static const size_t size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  return size;
+}
+
+// The transparent huge page size on x86-64 and most arm64 kernels.
+constexpr size_t huge_page_size = size_t(1) << 21;
+
+// Whole pages of page bytes covering bytes, at least one.
+inline size_t round_up(size_t bytes, size_t page = page_size()) {
+  return bytes ? (bytes + page - 1) / page * page : page;
+}
+
+inline void *map(size_t bytes) {
+  void *p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED) throw std::bad_alloc();
+  return p;
+}
+
+inline void unmap(void *p, size_t bytes) noexcept { ::munmap(p, bytes); }
+
+// Maps bytes at a multiple of align, a power of two of at least a page,
+// by over-mapping and trimming both ends.
+inline void *map_aligned(size_t bytes, size_t align) {
+  if (align <= page_size()) return map(bytes);
+  char *raw = static_cast<char *>(map(bytes + align - page_size()));
+  size_t mis = reinterpret_cast<size_t>(raw) & (align - 1);
+  size_t head = mis ? align - mis : 0;
+  if (head) unmap(raw, head);
+  size_t tail = align - page_size() - head;
+  if (tail) unmap(raw + head + bytes, tail);
+  return raw + head;
+}
+
+// Hands the pages back to the kernel while keeping the mapping; they read
+// as zeros if touched again.
+inline void release(void *p, size_t bytes) noexcept {
+  ::madvise(p, bytes, MADV_DONTNEED);
+}
+
+// Asks for transparent huge pages, which the kernel may only use in
+// aligned runs of huge_page_size bytes.
+inline void advise_huge(void *p, size_t bytes) noexcept {
+#ifdef MADV_HUGEPAGE
+  ::madvise(p, bytes, MADV_HUGEPAGE);
+#else
+  (void)p, (void)bytes;
+#endif
+}
+
+// Faults the pages in up front, writable, so first use takes no faults.
+inline void populate(void *p, size_t bytes) noexcept {
+#ifdef MADV_POPULATE_WRITE
+  if (::madvise(p, bytes, MADV_POPULATE_WRITE) == 0) return;
+#endif
+  volatile char *c = static_cast<char *>(p);
+  for (size_t off = 0; off < bytes; off += page_size()) c[off] = 0;
+}
+
+// Moves the first keep bytes of the mapping p into a fresh one of
+// new_bytes aligned to align, step bytes at a time, releasing each step
+// of p once it has been copied. Only about one step is ever resident
+// twice.
+inline void *relocate_in_steps(void *p, size_t old_bytes, size_t new_bytes,
+                               size_t keep, size_t align) {
+  const size_t step = 256 * page_size();
+  char *np = static_cast<char *>(map_aligned(new_bytes, align));
+  char *src = static_cast<char *>(p);
+  for (size_t off = 0; off < keep; off += step) {
+    size_t n = keep - off < step ? keep - off : step;
+    std::memcpy(np + off, src + off, n);
+    release(src + off, round_up(n));
+  }
+  unmap(p, old_bytes);
+  return np;
+}
+
+// Resizes the mapping p, keeping its first keep bytes and an address that
+// is a multiple of align. With mremap the kernel moves page table entries
+// and no byte is copied; a mapping that cannot grow where it is moves
+// into a freshly aligned range.
+inline void *remap(void *p, size_t old_bytes, size_t new_bytes, size_t keep,
+                   size_t align = page_size()) {
+#if SJTU_HAS_MREMAP
+  if (align <= page_size()) {
+    void *np = ::mremap(p, old_bytes, new_bytes, MREMAP_MAYMOVE);
+    if (np != MAP_FAILED) return np;
+  } else {
+    void *np = ::mremap(p, old_bytes, new_bytes, 0);
+    if (np != MAP_FAILED) return np;
+    void *dst = map_aligned(new_bytes, align);
+    np = ::mremap(p, old_bytes, new_bytes, MREMAP_MAYMOVE | MREMAP_FIXED, dst);
+    if (np != MAP_FAILED) return np;
+    unmap(dst, new_bytes);
+  }
+#endif
+  return relocate_in_steps(p, old_bytes, new_bytes, keep, align);
+}
+
+}  // namespace pages
+}  // namespace detail
+
+// An allocator that maps every buffer straight from the kernel in whole
+// pages, for large vectors whose peak memory matters. Regrowth through
+// reallocate never holds two full copies of the elements: the mapping is
+// moved with mremap, or, without it, copied a step at a time with each
+// copied step of the old buffer released at once. sjtu::vector uses
+// reallocate for trivially copyable T; other elements are moved between
+// two live buffers as usual.
+//
+// Each buffer takes at least one page, so small vectors are better off
+// with the default allocator.
+template <typename T>
+class page_allocator {
+ public:
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  constexpr page_allocator() = default;
+  template <typename U>
+  constexpr page_allocator(const page_allocator<U> &) noexcept {}
+
+  T *allocate(size_t n) {
+    if (n > size_t(-1) / 2 / sizeof(T)) throw std::bad_alloc();
+    return static_cast<T *>(detail::pages::map(bytes(n)));
+  }
+  void deallocate(T *p, size_t n) noexcept {
+    detail::pages::unmap(p, bytes(n));
+  }
+  // Keeps the first min(old_n, n) elements bytewise; p is untouched if
+  // this throws.
+  T *reallocate(T *p, size_t old_n, size_t n) {
+    if (p == nullptr) return allocate(n);
+    if (n > size_t(-1) / 2 / sizeof(T)) throw std::bad_alloc();
+    size_t old_bytes = bytes(old_n), new_bytes = bytes(n);
+    if (old_bytes == new_bytes) return p;
+    size_t keep = (old_n < n ? old_n : n) * sizeof(T);
+    return static_cast<T *>(
+        detail::pages::remap(p, old_bytes, new_bytes, keep));
+  }
+
+ private:
+  static size_t bytes(size_t n) {
+    return detail::pages::round_up(n * sizeof(T));
+  }
+};
+
+template <typename T, typename U>
+constexpr bool operator==(const page_allocator<T> &,
+                          const page_allocator<U> &) {
+  return true;
+}
+template <typename T, typename U>
+constexpr bool operator!=(const page_allocator<T> &,
+                          const page_allocator<U> &) {
+  return false;
+}
+
+// An allocator for multi-gigabyte vectors. Buffers of at least HeapBelow
+// bytes are mapped in whole huge pages at 2 MiB aligned addresses and
+// advised for transparent huge pages, so that one TLB entry and one page
+// fault cover what would take 512 small pages; with Populate they are
+// also faulted in when mapped. Such buffers grow with mremap, in place
+// when the address space after them is free. Smaller buffers come from
+// sjtu::allocator, so a vector only switches to mappings once it is big
+// enough to fill them.
+template <typename T, size_t HeapBelow = detail::pages::huge_page_size,
+          bool Populate = false>
+class huge_page_allocator {
+ private:
+  using heap = allocator<T>;
+
+  static constexpr size_t huge = detail::pages::huge_page_size;
+
+  static bool mapped(size_t n) { return n * sizeof(T) >= HeapBelow; }
+  static size_t bytes(size_t n) {
+    return detail::pages::round_up(n * sizeof(T), huge);
+  }
+
+  static T *map(size_t n) {
+    size_t b = bytes(n);
+    void *p = detail::pages::map_aligned(b, huge);
+    detail::pages::advise_huge(p, b);
+    if (Populate) detail::pages::populate(p, b);
+    return static_cast<T *>(p);
+  }
+
+  // Moves the first keep elements to a fresh buffer for n elements.
+  T *move_to_new(T *p, size_t old_n, size_t n, size_t keep) {
+    T *np = allocate(n);
+    std::memcpy(static_cast<void *>(np), p, keep * sizeof(T));
+    deallocate(p, old_n);
+    return np;
+  }
+
+ public:
+  using value_type = T;
+  using is_always_equal = std::true_type;
+  template <typename U>
+  struct rebind {
+    using other = huge_page_allocator<U, HeapBelow, Populate>;
+  };
+
+  constexpr huge_page_allocator() = default;
+  template <typename U>
+  constexpr huge_page_allocator(
+      const huge_page_allocator<U, HeapBelow, Populate> &) noexcept {}
+
+  T *allocate(size_t n) {
+    if (n > size_t(-1) / 2 / sizeof(T)) throw std::bad_alloc();
+    return mapped(n) ? map(n) : heap().allocate(n);
+  }
+  void deallocate(T *p, size_t n) noexcept {
+    if (mapped(n)) {
+      detail::pages::unmap(p, bytes(n));
+    } else {
+      heap().deallocate(p, n);
+    }
+  }
+  // Keeps the first min(old_n, n) elements bytewise; p is untouched if
+  // this throws.
+  T *reallocate(T *p, size_t old_n, size_t n) {
+    if (p == nullptr) return allocate(n);
+    if (n > size_t(-1) / 2 / sizeof(T)) throw std::bad_alloc();
+    size_t keep = old_n < n ? old_n : n;
+    if (!mapped(old_n) && !mapped(n)) {
+      if constexpr (detail::has_reallocate<heap, T>::value) {
+        return heap().reallocate(p, old_n, n);
+      } else {
+        return move_to_new(p, old_n, n, keep);
+      }
+    }
+    if (!mapped(old_n) || !mapped(n)) return move_to_new(p, old_n, n, keep);
+    size_t old_bytes = bytes(old_n), new_bytes = bytes(n);
+    if (old_bytes == new_bytes) return p;
+    char *np = static_cast<char *>(detail::pages::remap(
+        p, old_bytes, new_bytes, keep * sizeof(T), huge));
+    detail::pages::advise_huge(np, new_bytes);
+    if (Populate && new_bytes > old_bytes) {
+      detail::pages::populate(np + old_bytes, new_bytes - old_bytes);
+    }
+    return reinterpret_cast<T *>(np);
+  }
+};
+
+template <typename T, typename U, size_t H, bool P>
+constexpr bool operator==(const huge_page_allocator<T, H, P> &,
+                          const huge_page_allocator<U, H, P> &) {
+  return true;
+}
+template <typename T, typename U, size_t H, bool P>
+constexpr bool operator!=(const huge_page_allocator<T, H, P> &,
+                          const huge_page_allocator<U, H, P> &) {
+  return false;
+}
+
+}  // namespace sjtu
+
+#endif
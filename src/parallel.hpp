@@ -0,0 +1,283 @@
+#ifndef SJTU_PARALLEL_HPP
+#define SJTU_PARALLEL_HPP
+
+#include "vector.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace sjtu {
+namespace parallel {
+
+// A fixed set of worker threads that runs fork-join jobs of numbered
+// tasks. Each participant, the calling thread included, starts with an
+// even share of the task range and takes tasks from its front; one that
+// runs dry steals the back half of another's remaining range. Ranges are
+// packed into one atomic word, so taking and stealing are single CASes.
+//
+// A job started while the pool is busy, or from inside one of its tasks,
+// runs serially on the calling thread instead of waiting.
+class thread_pool {
+ private:
+  struct alignas(64) task_range {
+    std::atomic<uint64_t> bounds{0};
+  };
+
+  static uint64_t pack(uint64_t lo, uint64_t hi) { return hi << 32 | lo; }
+  static uint64_t lo_of(uint64_t r) { return r & 0xffffffffu; }
+  static uint64_t hi_of(uint64_t r) { return r >> 32; }
+
+  vector<std::thread> threads_;
+  std::unique_ptr<task_range[]> ranges_;
+  size_t participants_;
+
+  std::mutex submit_;
+  std::mutex m_;
+  std::condition_variable start_cv_;
+  std::condition_variable done_cv_;
+  uint64_t generation_ = 0;
+  size_t pending_ = 0;
+  bool stop_ = false;
+
+  void (*job_)(void *, size_t) = nullptr;
+  void *ctx_ = nullptr;
+  std::atomic<bool> failed_{false};
+  std::mutex error_m_;
+  std::exception_ptr error_;
+
+  static bool &inside_job() {
+    thread_local bool flag = false;
+    return flag;
+  }
+
+  bool take(size_t p, size_t &task) {
+    std::atomic<uint64_t> &b = ranges_[p].bounds;
+    uint64_t r = b.load(std::memory_order_relaxed);
+    while (lo_of(r) < hi_of(r)) {
+      if (b.compare_exchange_weak(r, pack(lo_of(r) + 1, hi_of(r)),
+                                  std::memory_order_relaxed)) {
+        task = lo_of(r);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Moves the back half of some other participant's range to p and
+  // returns its first task. Tasks finished by their owner never reappear
+  // in any range, so a stale CAS cannot succeed by coincidence.
+  bool steal(size_t p, size_t &task) {
+    size_t n = participants_;
+    for (size_t k = 1; k < n; ++k) {
+      std::atomic<uint64_t> &b = ranges_[(p + k) % n].bounds;
+      uint64_t r = b.load(std::memory_order_relaxed);
+      while (lo_of(r) < hi_of(r)) {
+        uint64_t lo = lo_of(r), hi = hi_of(r);
+        uint64_t mid = lo + (hi - lo) / 2;
+        if (b.compare_exchange_weak(r, pack(lo, mid),
+                                    std::memory_order_relaxed)) {
+          ranges_[p].bounds.store(pack(mid + 1, hi),
+                                  std::memory_order_relaxed);
+          task = mid;
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  // After the first exception the remaining tasks are skipped.
+  void work(size_t p) {
+    inside_job() = true;
+    size_t task;
+    while (take(p, task) || steal(p, task)) {
+      if (failed_.load(std::memory_order_relaxed)) continue;
+      try {
+        job_(ctx_, task);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_m_);
+        if (!error_) error_ = std::current_exception();
+        failed_.store(true, std::memory_order_relaxed);
+      }
+    }
+    inside_job() = false;
+  }
+
+  void worker_loop(size_t p) {
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(m_);
+    for (;;) {
+      start_cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+      if (stop_) return;
+      seen = generation_;
+      lock.unlock();
+      work(p);
+      lock.lock();
+      if (--pending_ == 0) done_cv_.notify_one();
+    }
+  }
+
+ public:
+  // threads counts the participants including the caller of run(), so a
+  // pool of 1 starts no threads at all.
+  explicit thread_pool(size_t threads = std::thread::hardware_concurrency())
+      : participants_(threads ? threads : 1) {
+    ranges_.reset(new task_range[participants_]);
+    threads_.reserve(participants_ - 1);
+    for (size_t p = 1; p < participants_; ++p) {
+      threads_.emplace_back([this, p] { worker_loop(p); });
+    }
+  }
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+  ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      stop_ = true;
+    }
+    start_cv_.notify_all();
+    for (std::thread &t : threads_) t.join();
+  }
+
+  size_t size() const { return participants_; }
+
+  // Calls fn(i) for every i in [0, tasks) and returns once all calls have
+  // finished. The first exception thrown by fn is rethrown here.
+  template <typename Fn>
+  void run(size_t tasks, Fn &&fn) {
+    if (tasks == 0) return;
+    if (tasks == 1 || threads_.empty() || inside_job() ||
+        !submit_.try_lock()) {
+      for (size_t i = 0; i < tasks; ++i) fn(i);
+      return;
+    }
+    std::lock_guard<std::mutex> submit(submit_, std::adopt_lock);
+    using F = std::remove_reference_t<Fn>;
+    job_ = [](void *ctx, size_t i) { (*static_cast<F *>(ctx))(i); };
+    ctx_ = const_cast<void *>(static_cast<const void *>(&fn));
+    failed_.store(false, std::memory_order_relaxed);
+    error_ = nullptr;
+    size_t n = participants_;
+    for (size_t p = 0; p < n; ++p) {
+      ranges_[p].bounds.store(pack(tasks * p / n, tasks * (p + 1) / n),
+                              std::memory_order_relaxed);
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      pending_ = n - 1;
+      ++generation_;
+    }
+    start_cv_.notify_all();
+    work(0);
+    {
+      std::unique_lock<std::mutex> lock(m_);
+      done_cv_.wait(lock, [&] { return pending_ == 0; });
+    }
+    if (error_) std::rethrow_exception(error_);
+  }
+};
+
+// The pool the algorithms use unless given one: one participant per core.
+inline thread_pool &default_pool() {
+  static thread_pool pool;
+  return pool;
+}
+
+namespace detail {
+
+// Elements per chunk. It depends on the input size and the element size
+// only, never on the pool, so reductions group their operands the same
+// way on any machine: about 256 chunks, each between 4 KiB and 64 KiB of
+// elements so a chunk stays in L2 and is big enough to amortize a steal.
+template <typename T>
+size_t chunk_size(size_t n) {
+  size_t lo = 4096 / sizeof(T) ? 4096 / sizeof(T) : 1;
+  size_t hi = 65536 / sizeof(T) > lo ? 65536 / sizeof(T) : lo;
+  size_t c = (n + 255) / 256;
+  return c < lo ? lo : c > hi ? hi : c;
+}
+
+// Runs fn(first, last) over the chunks of [0, n).
+template <typename T, typename Fn>
+void for_chunks(size_t n, thread_pool &pool, Fn &&fn) {
+  size_t chunk = chunk_size<T>(n);
+  size_t chunks = (n + chunk - 1) / chunk;
+  pool.run(chunks, [&](size_t c) {
+    size_t first = c * chunk;
+    fn(first, first + chunk < n ? first + chunk : n);
+  });
+}
+
+}  // namespace detail
+
+// The algorithms take any contiguous range with data() and size(): a
+// sjtu::vector, a span over one, a small_vector or a devector.
+
+// Calls fn(x) for every element x of r.
+template <typename Range, typename Fn>
+void for_each(Range &&r, Fn fn, thread_pool &pool = default_pool()) {
+  auto *data = r.data();
+  using T = std::remove_reference_t<decltype(*data)>;
+  detail::for_chunks<T>(r.size(), pool, [&](size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) fn(data[i]);
+  });
+}
+
+// Sets out[i] = fn(in[i]) for every i < in.size(). out must already hold
+// at least in.size() elements.
+template <typename In, typename Out, typename Fn>
+void transform(const In &in, Out &&out, Fn fn,
+               thread_pool &pool = default_pool()) {
+  if (out.size() < in.size()) throw index_out_of_bound();
+  auto *src = in.data();
+  auto *dst = out.data();
+  using T = std::remove_reference_t<decltype(*dst)>;
+  detail::for_chunks<T>(in.size(), pool, [&](size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) dst[i] = fn(src[i]);
+  });
+}
+
+// Folds fn(x) over r with op, starting from init. op must be associative
+// up to the caller's tolerance but need not be commutative: each chunk is
+// folded left to right, then init and the chunk results are folded in
+// order. The grouping depends only on r.size(), so the result is the same
+// from run to run and for any pool, even for floating point.
+template <typename Range, typename R, typename Op, typename Fn>
+R transform_reduce(const Range &r, R init, Op op, Fn fn,
+                   thread_pool &pool = default_pool()) {
+  auto *data = r.data();
+  using T = std::remove_reference_t<decltype(*data)>;
+  size_t n = r.size();
+  size_t chunk = detail::chunk_size<T>(n);
+  vector<std::optional<R>> partial((n + chunk - 1) / chunk);
+  detail::for_chunks<T>(n, pool, [&](size_t first, size_t last) {
+    R acc(fn(data[first]));
+    for (size_t i = first + 1; i < last; ++i) {
+      acc = op(std::move(acc), fn(data[i]));
+    }
+    partial[first / chunk].emplace(std::move(acc));
+  });
+  for (std::optional<R> &p : partial) {
+    init = op(std::move(init), std::move(*p));
+  }
+  return init;
+}
+
+template <typename Range, typename R, typename Op = std::plus<>>
+R reduce(const Range &r, R init, Op op = Op(),
+         thread_pool &pool = default_pool()) {
+  using T = std::remove_reference_t<decltype(*r.data())>;
+  return transform_reduce(r, std::move(init), op,
+                          [](const T &x) -> const T & { return x; }, pool);
+}
+
+}  // namespace parallel
+}  // namespace sjtu
+
+#endif
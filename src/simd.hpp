@@ -0,0 +1,615 @@
+#ifndef SJTU_SIMD_HPP
+#define SJTU_SIMD_HPP
+
+#include "vector.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// The vector paths need GCC's target pragmas and x86 intrinsics; anywhere
+// else every call takes the scalar path.
+#if defined(__GNUC__) && !defined(__clang__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define SJTU_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define SJTU_SIMD_X86 0
+#endif
+
+namespace sjtu {
+namespace simd {
+
+// Instruction sets the algorithms can dispatch to, in increasing order.
+enum class level { scalar, sse2, avx2, avx512 };
+
+namespace detail {
+
+// The best level this CPU and OS support.
+inline level detect() {
+#if SJTU_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return level::avx512;
+  if (__builtin_cpu_supports("avx2")) return level::avx2;
+  if (__builtin_cpu_supports("sse2")) return level::sse2;
+#endif
+  return level::scalar;
+}
+
+inline level &active() {
+  static level l = detect();
+  return l;
+}
+
+template <typename T>
+struct vectorized
+    : std::integral_constant<bool, std::is_same<T, int>::value ||
+                                       std::is_same<T, long long>::value ||
+                                       std::is_same<T, double>::value> {};
+
+// sum() widens int to long long; other types sum in their own type.
+template <typename T>
+using sum_t = std::conditional_t<std::is_same<T, int>::value, long long, T>;
+
+// min_element and max_element go through the input in blocks of this
+// many elements and only revisit the block holding the answer.
+constexpr size_t extreme_block = 4096;
+
+// Adds up the lanes of a partial sum pairwise; n is a power of two.
+template <typename S>
+S combine(S *part, size_t n) {
+  for (size_t w = n / 2; w > 0; w /= 2) {
+    for (size_t j = 0; j < w; ++j) part[j] += part[j + w];
+  }
+  return part[0];
+}
+
+// value + i without signed overflow, the i-th element iota writes.
+template <typename T>
+T iota_at(T value, size_t i) {
+  if constexpr (std::is_integral<T>::value) {
+    using U = std::make_unsigned_t<T>;
+    return T(U(value) + U(i));
+  } else {
+    return value + T(i);
+  }
+}
+
+namespace scalar {
+
+// Doubles are added into 16 interleaved partial sums and combined
+// pairwise, exactly as the vector kernels do, so the result does not
+// depend on the instruction set. Everything else adds left to right.
+template <typename T>
+sum_t<T> sum(const T *p, size_t n) {
+  if constexpr (std::is_same<T, double>::value) {
+    constexpr size_t step = 128 / sizeof(T);
+    double part[step] = {};
+    for (size_t i = 0; i < n; ++i) part[i % step] += p[i];
+    return combine(part, step);
+  } else {
+    sum_t<T> acc = sum_t<T>();
+    for (size_t i = 0; i < n; ++i) acc += p[i];
+    return acc;
+  }
+}
+
+template <bool Max, typename T>
+T block_extreme(const T *p, size_t n) {
+  T best = p[0];
+  for (size_t i = 1; i < n; ++i) {
+    if (Max ? best < p[i] : p[i] < best) best = p[i];
+  }
+  return best;
+}
+
+template <bool Max, typename T>
+size_t extreme(const T *p, size_t n) {
+  size_t at = 0;
+  for (size_t i = 1; i < n; ++i) {
+    if (Max ? p[at] < p[i] : p[i] < p[at]) at = i;
+  }
+  return at;
+}
+
+template <typename T>
+size_t find(const T *p, size_t n, const T &value) {
+  for (size_t i = 0; i < n; ++i) {
+    if (p[i] == value) return i;
+  }
+  return n;
+}
+
+template <typename T>
+size_t count(const T *p, size_t n, const T &value) {
+  size_t c = 0;
+  for (size_t i = 0; i < n; ++i) c += p[i] == value;
+  return c;
+}
+
+template <typename T>
+void fill(T *p, size_t n, const T &value) {
+  for (size_t i = 0; i < n; ++i) p[i] = value;
+}
+
+template <typename T>
+void iota(T *p, size_t n, T value) {
+  for (size_t i = 0; i < n; ++i, ++value) p[i] = value;
+}
+
+}  // namespace scalar
+
+#if SJTU_SIMD_X86
+
+#pragma GCC push_options
+#pragma GCC target("sse2")
+namespace sse2 {
+
+template <typename T>
+struct ops;
+
+template <>
+struct ops<int> {
+  using reg = __m128i;
+  static constexpr size_t lanes = 4;
+  static constexpr bool has_minmax = true;
+  static reg load(const int *p) { return _mm_loadu_si128((const reg *)p); }
+  static void store(int *p, reg a) { _mm_storeu_si128((reg *)p, a); }
+  static reg set1(int v) { return _mm_set1_epi32(v); }
+  static reg add(reg a, reg b) { return _mm_add_epi32(a, b); }
+  static reg select(reg m, reg a, reg b) {
+    return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+  }
+  static reg min(reg a, reg b) { return select(_mm_cmplt_epi32(a, b), a, b); }
+  static reg max(reg a, reg b) { return select(_mm_cmpgt_epi32(a, b), a, b); }
+  static unsigned eq_mask(reg a, reg b) {
+    return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)));
+  }
+  static reg iota_base(int v) {
+    return _mm_add_epi32(set1(v), _mm_setr_epi32(0, 1, 2, 3));
+  }
+
+  // SSE2 has no sign extension, so the sign is unpacked in by hand.
+  using sum_type = long long;
+  struct sum_acc {
+    reg lo, hi;
+  };
+  static sum_acc sum_zero() {
+    return {_mm_setzero_si128(), _mm_setzero_si128()};
+  }
+  static sum_acc sum_add(sum_acc s, reg x) {
+    reg sign = _mm_srai_epi32(x, 31);
+    return {_mm_add_epi64(s.lo, _mm_unpacklo_epi32(x, sign)),
+            _mm_add_epi64(s.hi, _mm_unpackhi_epi32(x, sign))};
+  }
+  static void sum_store(long long *p, sum_acc s) {
+    _mm_storeu_si128((reg *)p, s.lo);
+    _mm_storeu_si128((reg *)(p + 2), s.hi);
+  }
+};
+
+// SSE2 cannot compare 64-bit integers for order, so min_element and
+// max_element on long long stay scalar at this level.
+template <>
+struct ops<long long> {
+  using reg = __m128i;
+  static constexpr size_t lanes = 2;
+  static constexpr bool has_minmax = false;
+  static reg load(const long long *p) {
+    return _mm_loadu_si128((const reg *)p);
+  }
+  static void store(long long *p, reg a) { _mm_storeu_si128((reg *)p, a); }
+  static reg set1(long long v) { return _mm_set1_epi64x(v); }
+  static reg add(reg a, reg b) { return _mm_add_epi64(a, b); }
+  static unsigned eq_mask(reg a, reg b) {
+    reg eq = _mm_cmpeq_epi32(a, b);
+    eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_movemask_pd(_mm_castsi128_pd(eq));
+  }
+  static reg iota_base(long long v) {
+    return _mm_add_epi64(set1(v), _mm_set_epi64x(1, 0));
+  }
+
+  using sum_type = long long;
+  using sum_acc = reg;
+  static reg sum_zero() { return _mm_setzero_si128(); }
+  static reg sum_add(reg s, reg x) { return add(s, x); }
+  static void sum_store(long long *p, reg s) { store(p, s); }
+};
+
+template <>
+struct ops<double> {
+  using reg = __m128d;
+  static constexpr size_t lanes = 2;
+  static constexpr bool has_minmax = true;
+  static reg load(const double *p) { return _mm_loadu_pd(p); }
+  static void store(double *p, reg a) { _mm_storeu_pd(p, a); }
+  static reg set1(double v) { return _mm_set1_pd(v); }
+  static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+  static reg min(reg a, reg b) { return _mm_min_pd(a, b); }
+  static reg max(reg a, reg b) { return _mm_max_pd(a, b); }
+  static unsigned eq_mask(reg a, reg b) {
+    return _mm_movemask_pd(_mm_cmpeq_pd(a, b));
+  }
+  static reg iota_base(double v) {
+    return _mm_add_pd(set1(v), _mm_setr_pd(0, 1));
+  }
+
+  using sum_type = double;
+  using sum_acc = reg;
+  static reg sum_zero() { return _mm_setzero_pd(); }
+  static reg sum_add(reg s, reg x) { return add(s, x); }
+  static void sum_store(double *p, reg s) { store(p, s); }
+};
+
+}  // namespace sse2
+}  // namespace detail
+}  // namespace simd
+}  // namespace sjtu
+#define SJTU_SIMD_ISA sse2
+#include "simd_kernels.hpp"
+#undef SJTU_SIMD_ISA
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2,popcnt")
+namespace sjtu {
+namespace simd {
+namespace detail {
+namespace avx2 {
+
+template <typename T>
+struct ops;
+
+template <>
+struct ops<int> {
+  using reg = __m256i;
+  static constexpr size_t lanes = 8;
+  static constexpr bool has_minmax = true;
+  static reg load(const int *p) { return _mm256_loadu_si256((const reg *)p); }
+  static void store(int *p, reg a) { _mm256_storeu_si256((reg *)p, a); }
+  static reg set1(int v) { return _mm256_set1_epi32(v); }
+  static reg add(reg a, reg b) { return _mm256_add_epi32(a, b); }
+  static reg min(reg a, reg b) { return _mm256_min_epi32(a, b); }
+  static reg max(reg a, reg b) { return _mm256_max_epi32(a, b); }
+  static unsigned eq_mask(reg a, reg b) {
+    return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)));
+  }
+  static reg iota_base(int v) {
+    return _mm256_add_epi32(set1(v), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+  }
+
+  using sum_type = long long;
+  struct sum_acc {
+    reg lo, hi;
+  };
+  static sum_acc sum_zero() {
+    return {_mm256_setzero_si256(), _mm256_setzero_si256()};
+  }
+  static sum_acc sum_add(sum_acc s, reg x) {
+    reg lo = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x));
+    reg hi = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1));
+    return {_mm256_add_epi64(s.lo, lo), _mm256_add_epi64(s.hi, hi)};
+  }
+  static void sum_store(long long *p, sum_acc s) {
+    _mm256_storeu_si256((reg *)p, s.lo);
+    _mm256_storeu_si256((reg *)(p + 4), s.hi);
+  }
+};
+
+template <>
+struct ops<long long> {
+  using reg = __m256i;
+  static constexpr size_t lanes = 4;
+  static constexpr bool has_minmax = true;
+  static reg load(const long long *p) {
+    return _mm256_loadu_si256((const reg *)p);
+  }
+  static void store(long long *p, reg a) { _mm256_storeu_si256((reg *)p, a); }
+  static reg set1(long long v) { return _mm256_set1_epi64x(v); }
+  static reg add(reg a, reg b) { return _mm256_add_epi64(a, b); }
+  static reg min(reg a, reg b) {
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+  }
+  static reg max(reg a, reg b) {
+    return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+  }
+  static unsigned eq_mask(reg a, reg b) {
+    return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b)));
+  }
+  static reg iota_base(long long v) {
+    return _mm256_add_epi64(set1(v), _mm256_set_epi64x(3, 2, 1, 0));
+  }
+
+  using sum_type = long long;
+  using sum_acc = reg;
+  static reg sum_zero() { return _mm256_setzero_si256(); }
+  static reg sum_add(reg s, reg x) { return add(s, x); }
+  static void sum_store(long long *p, reg s) { store(p, s); }
+};
+
+template <>
+struct ops<double> {
+  using reg = __m256d;
+  static constexpr size_t lanes = 4;
+  static constexpr bool has_minmax = true;
+  static reg load(const double *p) { return _mm256_loadu_pd(p); }
+  static void store(double *p, reg a) { _mm256_storeu_pd(p, a); }
+  static reg set1(double v) { return _mm256_set1_pd(v); }
+  static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+  static reg min(reg a, reg b) { return _mm256_min_pd(a, b); }
+  static reg max(reg a, reg b) { return _mm256_max_pd(a, b); }
+  static unsigned eq_mask(reg a, reg b) {
+    return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ));
+  }
+  static reg iota_base(double v) {
+    return _mm256_add_pd(set1(v), _mm256_setr_pd(0, 1, 2, 3));
+  }
+
+  using sum_type = double;
+  using sum_acc = reg;
+  static reg sum_zero() { return _mm256_setzero_pd(); }
+  static reg sum_add(reg s, reg x) { return add(s, x); }
+  static void sum_store(double *p, reg s) { store(p, s); }
+};
+
+}  // namespace avx2
+}  // namespace detail
+}  // namespace simd
+}  // namespace sjtu
+#define SJTU_SIMD_ISA avx2
+#include "simd_kernels.hpp"
+#undef SJTU_SIMD_ISA
+#pragma GCC pop_options
+
+// GCC 12 reports the undefined upper halves in its own AVX-512 intrinsics
+// as maybe-uninitialized (PR 105593).
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx2,popcnt")
+namespace sjtu {
+namespace simd {
+namespace detail {
+namespace avx512 {
+
+template <typename T>
+struct ops;
+
+template <>
+struct ops<int> {
+  using reg = __m512i;
+  static constexpr size_t lanes = 16;
+  static constexpr bool has_minmax = true;
+  static reg load(const int *p) { return _mm512_loadu_si512(p); }
+  static void store(int *p, reg a) { _mm512_storeu_si512(p, a); }
+  static reg set1(int v) { return _mm512_set1_epi32(v); }
+  static reg add(reg a, reg b) { return _mm512_add_epi32(a, b); }
+  static reg min(reg a, reg b) { return _mm512_min_epi32(a, b); }
+  static reg max(reg a, reg b) { return _mm512_max_epi32(a, b); }
+  static unsigned eq_mask(reg a, reg b) {
+    return _mm512_cmpeq_epi32_mask(a, b);
+  }
+  static reg iota_base(int v) {
+    return _mm512_add_epi32(set1(v),
+                            _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7,
+                                             6, 5, 4, 3, 2, 1, 0));
+  }
+
+  using sum_type = long long;
+  struct sum_acc {
+    reg lo, hi;
+  };
+  static sum_acc sum_zero() {
+    return {_mm512_setzero_si512(), _mm512_setzero_si512()};
+  }
+  static sum_acc sum_add(sum_acc s, reg x) {
+    reg lo = _mm512_cvtepi32_epi64(_mm512_castsi512_si256(x));
+    reg hi = _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(x, 1));
+    return {_mm512_add_epi64(s.lo, lo), _mm512_add_epi64(s.hi, hi)};
+  }
+  static void sum_store(long long *p, sum_acc s) {
+    _mm512_storeu_si512(p, s.lo);
+    _mm512_storeu_si512(p + 8, s.hi);
+  }
+};
+
+template <>
+struct ops<long long> {
+  using reg = __m512i;
+  static constexpr size_t lanes = 8;
+  static constexpr bool has_minmax = true;
+  static reg load(const long long *p) { return _mm512_loadu_si512(p); }
+  static void store(long long *p, reg a) { _mm512_storeu_si512(p, a); }
+  static reg set1(long long v) { return _mm512_set1_epi64(v); }
+  static reg add(reg a, reg b) { return _mm512_add_epi64(a, b); }
+  static reg min(reg a, reg b) { return _mm512_min_epi64(a, b); }
+  static reg max(reg a, reg b) { return _mm512_max_epi64(a, b); }
+  static unsigned eq_mask(reg a, reg b) {
+    return _mm512_cmpeq_epi64_mask(a, b);
+  }
+  static reg iota_base(long long v) {
+    return _mm512_add_epi64(set1(v), _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0));
+  }
+
+  using sum_type = long long;
+  using sum_acc = reg;
+  static reg sum_zero() { return _mm512_setzero_si512(); }
+  static reg sum_add(reg s, reg x) { return add(s, x); }
+  static void sum_store(long long *p, reg s) { store(p, s); }
+};
+
+template <>
+struct ops<double> {
+  using reg = __m512d;
+  static constexpr size_t lanes = 8;
+  static constexpr bool has_minmax = true;
+  static reg load(const double *p) { return _mm512_loadu_pd(p); }
+  static void store(double *p, reg a) { _mm512_storeu_pd(p, a); }
+  static reg set1(double v) { return _mm512_set1_pd(v); }
+  static reg add(reg a, reg b) { return _mm512_add_pd(a, b); }
+  static reg min(reg a, reg b) { return _mm512_min_pd(a, b); }
+  static reg max(reg a, reg b) { return _mm512_max_pd(a, b); }
+  static unsigned eq_mask(reg a, reg b) {
+    return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ);
+  }
+  static reg iota_base(double v) {
+    return _mm512_add_pd(set1(v), _mm512_set_pd(7, 6, 5, 4, 3, 2, 1, 0));
+  }
+
+  using sum_type = double;
+  using sum_acc = reg;
+  static reg sum_zero() { return _mm512_setzero_pd(); }
+  static reg sum_add(reg s, reg x) { return add(s, x); }
+  static void sum_store(double *p, reg s) { store(p, s); }
+};
+
+}  // namespace avx512
+}  // namespace detail
+}  // namespace simd
+}  // namespace sjtu
+#define SJTU_SIMD_ISA avx512
+#include "simd_kernels.hpp"
+#undef SJTU_SIMD_ISA
+#pragma GCC pop_options
+#pragma GCC diagnostic pop
+
+namespace sjtu {
+namespace simd {
+namespace detail {
+
+#endif  // SJTU_SIMD_X86
+
+// Calls the kernel for the active level, or the scalar one for types
+// without vector kernels.
+#if SJTU_SIMD_X86
+#define SJTU_SIMD_DISPATCH(T, name, ...)                        \
+  do {                                                          \
+    if constexpr (vectorized<T>::value) {                       \
+      switch (active()) {                                       \
+        case level::avx512:                                     \
+          return avx512::name(__VA_ARGS__);                     \
+        case level::avx2:                                       \
+          return avx2::name(__VA_ARGS__);                       \
+        case level::sse2:                                       \
+          return sse2::name(__VA_ARGS__);                       \
+        case level::scalar:                                     \
+          break;                                                \
+      }                                                         \
+    }                                                           \
+    return scalar::name(__VA_ARGS__);                           \
+  } while (false)
+#else
+#define SJTU_SIMD_DISPATCH(T, name, ...) return scalar::name(__VA_ARGS__)
+#endif
+
+template <typename T>
+sum_t<T> sum(const T *p, size_t n) {
+  SJTU_SIMD_DISPATCH(T, sum, p, n);
+}
+
+template <bool Max, typename T>
+size_t extreme(const T *p, size_t n) {
+  if (n == 0) return 0;
+  SJTU_SIMD_DISPATCH(T, extreme<Max>, p, n);
+}
+
+template <typename T>
+size_t find(const T *p, size_t n, const T &value) {
+  SJTU_SIMD_DISPATCH(T, find, p, n, value);
+}
+
+template <typename T>
+size_t count(const T *p, size_t n, const T &value) {
+  SJTU_SIMD_DISPATCH(T, count, p, n, value);
+}
+
+template <typename T>
+void fill(T *p, size_t n, const T &value) {
+  SJTU_SIMD_DISPATCH(T, fill, p, n, value);
+}
+
+// std::iota increments a double one step at a time; the vector kernels
+// add i to the start instead, which only agrees while every value is an
+// integer that a double holds exactly.
+template <typename T>
+void iota(T *p, size_t n, T value) {
+  if constexpr (std::is_floating_point<T>::value) {
+    if (value != std::floor(value) || std::fabs(value) + n > 0x1p53) {
+      return scalar::iota(p, n, value);
+    }
+  }
+  SJTU_SIMD_DISPATCH(T, iota, p, n, value);
+}
+
+#undef SJTU_SIMD_DISPATCH
+
+template <typename Range>
+using element_t =
+    std::remove_reference_t<decltype(*std::declval<Range &>().data())>;
+
+}  // namespace detail
+
+// The best level this machine supports.
+inline level supported_level() {
+  static level l = detail::detect();
+  return l;
+}
+
+// The level calls currently dispatch to; supported_level() by default.
+inline level active_level() { return detail::active(); }
+
+// Caps dispatch at l, clamped to supported_level(); meant for comparing
+// the paths in tests and benchmarks, not for use while other threads are
+// calling in.
+inline void set_level(level l) {
+  detail::active() = std::min(l, supported_level());
+}
+
+// The algorithms take any contiguous range with data() and size(). int,
+// long long and double get vector kernels; other element types take the
+// scalar loops. Positions are returned as indices, with size() meaning
+// "not found". Integer sums wrap; doubles are summed in 16 interleaved
+// partial sums whatever the level, so the result is the same on every
+// machine but may differ in the last bits from a left-to-right loop.
+// min_element and max_element return the first extreme element; ranges
+// of doubles must not contain NaN.
+
+template <typename Range>
+auto sum(const Range &r) {
+  return detail::sum(r.data(), r.size());
+}
+
+template <typename Range>
+size_t min_element(const Range &r) {
+  return detail::extreme<false>(r.data(), r.size());
+}
+
+template <typename Range>
+size_t max_element(const Range &r) {
+  return detail::extreme<true>(r.data(), r.size());
+}
+
+template <typename Range>
+size_t find(const Range &r, const detail::element_t<const Range> &value) {
+  return detail::find(r.data(), r.size(), value);
+}
+
+template <typename Range>
+size_t count(const Range &r, const detail::element_t<const Range> &value) {
+  return detail::count(r.data(), r.size(), value);
+}
+
+template <typename Range>
+void fill(Range &&r, const detail::element_t<Range> &value) {
+  detail::fill(r.data(), r.size(), value);
+}
+
+template <typename Range>
+void iota(Range &&r, detail::element_t<Range> value) {
+  detail::iota(r.data(), r.size(), value);
+}
+
+}  // namespace simd
+}  // namespace sjtu
+
+#endif
@@ -0,0 +1,154 @@
+// The vector kernels behind sjtu::simd. This file has no include guard on
+// purpose: simd.hpp includes it once per instruction set, inside a
+// #pragma GCC target region, with SJTU_SIMD_ISA naming the namespace that
+// holds that instruction set's ops<T>. ops<T> provides
+//   reg, lanes, load, store, set1, add, eq_mask, iota_base,
+//   has_minmax, min, max,
+//   sum_type, sum_acc, sum_zero, sum_add, sum_store.
+// Each kernel covers whole steps of 128 bytes with 128 / sizeof(T) / lanes
+// independent registers and finishes the tail with scalar code.
+
+namespace sjtu {
+namespace simd {
+namespace detail {
+namespace SJTU_SIMD_ISA {
+
+template <typename T>
+constexpr size_t regs = 128 / sizeof(T) / ops<T>::lanes;
+
+// Lane-wise partial sums land in the same 128 / sizeof(T) slots as
+// scalar::sum uses, so every instruction set adds doubles in one order.
+template <typename T>
+typename ops<T>::sum_type sum(const T *p, size_t n) {
+  using O = ops<T>;
+  using S = typename O::sum_type;
+  constexpr size_t R = regs<T>, step = R * O::lanes;
+  typename O::sum_acc acc[R];
+  for (size_t r = 0; r < R; ++r) acc[r] = O::sum_zero();
+  size_t i = 0;
+  for (; i + step <= n; i += step) {
+    for (size_t r = 0; r < R; ++r) {
+      acc[r] = O::sum_add(acc[r], O::load(p + i + r * O::lanes));
+    }
+  }
+  S part[step];
+  for (size_t r = 0; r < R; ++r) O::sum_store(part + r * O::lanes, acc[r]);
+  for (; i < n; ++i) part[i % step] += p[i];
+  return combine(part, step);
+}
+
+template <bool Max, typename T>
+T block_extreme(const T *p, size_t n) {
+  using O = ops<T>;
+  constexpr size_t R = regs<T>, step = R * O::lanes;
+  if (n < step) return scalar::block_extreme<Max>(p, n);
+  typename O::reg acc[R];
+  for (size_t r = 0; r < R; ++r) acc[r] = O::load(p + r * O::lanes);
+  size_t i = step;
+  for (; i + step <= n; i += step) {
+    for (size_t r = 0; r < R; ++r) {
+      typename O::reg x = O::load(p + i + r * O::lanes);
+      acc[r] = Max ? O::max(acc[r], x) : O::min(acc[r], x);
+    }
+  }
+  for (size_t r = 1; r < R; ++r) {
+    acc[0] = Max ? O::max(acc[0], acc[r]) : O::min(acc[0], acc[r]);
+  }
+  T lane[O::lanes];
+  O::store(lane, acc[0]);
+  T best = scalar::block_extreme<Max>(lane, O::lanes);
+  for (; i < n; ++i) {
+    if (Max ? best < p[i] : p[i] < best) best = p[i];
+  }
+  return best;
+}
+
+template <typename T>
+size_t find(const T *p, size_t n, const T &value) {
+  using O = ops<T>;
+  constexpr size_t R = regs<T>, step = R * O::lanes;
+  typename O::reg v = O::set1(value);
+  size_t i = 0;
+  for (; i + step <= n; i += step) {
+    for (size_t r = 0; r < R; ++r) {
+      unsigned m = O::eq_mask(O::load(p + i + r * O::lanes), v);
+      if (m != 0) return i + r * O::lanes + __builtin_ctz(m);
+    }
+  }
+  for (; i < n; ++i) {
+    if (p[i] == value) return i;
+  }
+  return n;
+}
+
+template <bool Max, typename T>
+size_t extreme(const T *p, size_t n) {
+  if constexpr (!ops<T>::has_minmax) {
+    return scalar::extreme<Max>(p, n);
+  } else {
+    size_t at = 0;
+    T best = p[0];
+    for (size_t b = 0; b < n; b += extreme_block) {
+      T m = block_extreme<Max>(p + b, std::min(extreme_block, n - b));
+      if (Max ? best < m : m < best) {
+        best = m;
+        at = b;
+      }
+    }
+    return at + find(p + at, std::min(extreme_block, n - at), best);
+  }
+}
+
+template <typename T>
+size_t count(const T *p, size_t n, const T &value) {
+  using O = ops<T>;
+  constexpr size_t R = regs<T>, step = R * O::lanes;
+  typename O::reg v = O::set1(value);
+  size_t c = 0, i = 0;
+  for (; i + step <= n; i += step) {
+    for (size_t r = 0; r < R; ++r) {
+      unsigned m = O::eq_mask(O::load(p + i + r * O::lanes), v);
+      // Up to four lanes: a nibble lookup, for CPUs without popcnt.
+      c += O::lanes <= 4 ? 0x4332322132212110ull >> (4 * m) & 0xf
+                         : __builtin_popcount(m);
+    }
+  }
+  for (; i < n; ++i) c += p[i] == value;
+  return c;
+}
+
+template <typename T>
+void fill(T *p, size_t n, const T &value) {
+  using O = ops<T>;
+  constexpr size_t R = regs<T>, step = R * O::lanes;
+  typename O::reg v = O::set1(value);
+  size_t i = 0;
+  for (; i + step <= n; i += step) {
+    for (size_t r = 0; r < R; ++r) O::store(p + i + r * O::lanes, v);
+  }
+  for (; i < n; ++i) p[i] = value;
+}
+
+template <typename T>
+void iota(T *p, size_t n, T value) {
+  using O = ops<T>;
+  constexpr size_t R = regs<T>, step = R * O::lanes;
+  typename O::reg cur[R];
+  for (size_t r = 0; r < R; ++r) {
+    cur[r] = O::iota_base(iota_at(value, r * O::lanes));
+  }
+  typename O::reg inc = O::set1(T(step));
+  size_t i = 0;
+  for (; i + step <= n; i += step) {
+    for (size_t r = 0; r < R; ++r) {
+      O::store(p + i + r * O::lanes, cur[r]);
+      cur[r] = O::add(cur[r], inc);
+    }
+  }
+  for (; i < n; ++i) p[i] = iota_at(value, i);
+}
+
+}  // namespace SJTU_SIMD_ISA
+}  // namespace detail
+}  // namespace simd
+}  // namespace sjtu
@@ -0,0 +1,401 @@
+#ifndef SJTU_SMALL_VECTOR_HPP
+#define SJTU_SMALL_VECTOR_HPP
+
+#include "vector.hpp"
+
+namespace sjtu {
+
+// A vector that keeps up to N elements inside the object itself and only
+// moves them to a heap buffer from Alloc once it grows past N. Iterators,
+// operator[] and the exceptions thrown match sjtu::vector; moving an
+// inline small_vector moves its elements rather than a pointer.
+template <typename T, size_t N, typename Alloc = allocator<T>>
+class small_vector : private detail::alloc_holder<Alloc> {
+  static_assert(N > 0, "small_vector needs at least one inline slot");
+
+ private:
+  using alloc_traits = std::allocator_traits<Alloc>;
+  using holder = detail::alloc_holder<Alloc>;
+  using holder::get_alloc;
+
+  T *data_;
+  size_t sz_ = 0;
+  size_t cap_ = N;
+  alignas(T) unsigned char buf_[N * sizeof(T)];
+
+  static constexpr bool trivially_relocatable =
+      std::is_trivially_copyable<T>::value;
+
+  T *inline_data() { return reinterpret_cast<T *>(buf_); }
+  const T *inline_data() const { return reinterpret_cast<const T *>(buf_); }
+
+  template <typename... Args>
+  void construct(T *p, Args &&...args) {
+    alloc_traits::construct(get_alloc(), p, std::forward<Args>(args)...);
+  }
+  void destroy(T *p) { alloc_traits::destroy(get_alloc(), p); }
+
+  void free_heap() {
+    if (!is_inline()) alloc_traits::deallocate(get_alloc(), data_, cap_);
+  }
+
+  // Moves the elements to nd (the inline buffer or a heap block of ncap
+  // slots), copying when T's move may throw so a failure changes nothing.
+  void relocate(T *nd, size_t ncap) {
+    if constexpr (trivially_relocatable) {
+      if (sz_ != 0) std::memcpy(nd, data_, sz_ * sizeof(T));
+    } else {
+      size_t i = 0;
+      try {
+        for (; i < sz_; ++i) construct(nd + i, std::move_if_noexcept(data_[i]));
+      } catch (...) {
+        for (size_t j = 0; j < i; ++j) destroy(nd + j);
+        throw;
+      }
+      for (size_t j = 0; j < sz_; ++j) destroy(data_ + j);
+    }
+    free_heap();
+    data_ = nd;
+    cap_ = ncap;
+  }
+
+  void reallocate(size_t ncap) {
+    T *nd = alloc_traits::allocate(get_alloc(), ncap);
+    try {
+      relocate(nd, ncap);
+    } catch (...) {
+      alloc_traits::deallocate(get_alloc(), nd, ncap);
+      throw;
+    }
+  }
+
+  void ensure_capacity(size_t need) {
+    if (need <= cap_) return;
+    size_t ncap = cap_ * 2;
+    while (ncap < need) ncap <<= 1;
+    reallocate(ncap);
+  }
+
+  template <typename InputIt>
+  void init_from(InputIt first, size_t n) {
+    ensure_capacity(n);
+    try {
+      for (; sz_ < n; ++sz_, ++first) construct(data_ + sz_, *first);
+    } catch (...) {
+      clear();
+      free_heap();
+      throw;
+    }
+  }
+
+  template <typename, typename>
+  friend class detail::contiguous_iterator;
+
+  bool holds(const T *p) const { return p >= data_ && p < data_ + sz_; }
+
+  template <typename It>
+  size_t index_of(const It &pos) const {
+    if (!pos.belongs_to(this) || pos.ptr_ < data_ || pos.ptr_ > data_ + sz_) {
+      throw invalid_iterator();
+    }
+    return pos.ptr_ - data_;
+  }
+
+  // Takes other's heap buffer, or moves its inline elements one by one;
+  // other is left empty. *this must be empty and inline, and its
+  // allocator must be able to free other's buffer. If a move throws, the
+  // elements moved so far are destroyed, which also covers its use in
+  // the move constructor, where no destructor would run.
+  void take(small_vector &other) {
+    if (other.is_inline()) {
+      try {
+        for (; sz_ < other.sz_; ++sz_) {
+          construct(data_ + sz_, std::move(other.data_[sz_]));
+        }
+      } catch (...) {
+        clear();
+        throw;
+      }
+      other.clear();
+    } else {
+      data_ = other.data_;
+      sz_ = other.sz_;
+      cap_ = other.cap_;
+      other.data_ = other.inline_data();
+      other.sz_ = 0;
+      other.cap_ = N;
+    }
+  }
+
+  // Moves other's elements one by one into storage from this allocator,
+  // for when it cannot free other's buffer. *this must be empty.
+  void take_elements(small_vector &other) {
+    ensure_capacity(other.sz_);
+    for (; sz_ < other.sz_; ++sz_) {
+      construct(data_ + sz_, std::move(other.data_[sz_]));
+    }
+    other.clear();
+  }
+
+  // Drops every element and any heap buffer, going back to inline.
+  void reset() {
+    clear();
+    free_heap();
+    data_ = inline_data();
+    cap_ = N;
+  }
+
+  // Moves this vector's inline elements into the unused inline buffer of
+  // heap-backed other, then trades buffers with it.
+  void swap_inline_with_heap(small_vector &other) {
+    T *dst = other.inline_data();
+    size_t i = 0;
+    try {
+      for (; i < sz_; ++i) {
+        other.construct(dst + i, std::move_if_noexcept(data_[i]));
+      }
+    } catch (...) {
+      for (size_t j = 0; j < i; ++j) other.destroy(dst + j);
+      throw;
+    }
+    clear();
+    data_ = other.data_;
+    sz_ = other.sz_;
+    cap_ = other.cap_;
+    other.data_ = dst;
+    other.sz_ = i;
+    other.cap_ = N;
+  }
+
+ public:
+  using iterator = detail::contiguous_iterator<small_vector, T>;
+  using const_iterator = detail::contiguous_iterator<small_vector, const T>;
+
+  small_vector() : data_(inline_data()) {}
+  explicit small_vector(const Alloc &alloc) noexcept
+      : holder(alloc), data_(inline_data()) {}
+  small_vector(std::initializer_list<T> il, const Alloc &alloc = Alloc())
+      : holder(alloc), data_(inline_data()) {
+    init_from(il.begin(), il.size());
+  }
+  small_vector(const small_vector &other)
+      : small_vector(other, alloc_traits::select_on_container_copy_construction(
+                                other.get_alloc())) {}
+  small_vector(const small_vector &other, const Alloc &alloc)
+      : holder(alloc), data_(inline_data()) {
+    init_from(other.data_, other.sz_);
+  }
+  small_vector(small_vector &&other) noexcept(
+      std::is_nothrow_move_constructible<T>::value)
+      : holder(other.get_alloc()), data_(inline_data()) {
+    take(other);
+  }
+  ~small_vector() {
+    clear();
+    free_heap();
+  }
+
+  // Copies into a vector on this allocator, or on other's when it
+  // propagates, and swaps that in.
+  small_vector &operator=(const small_vector &other) {
+    if (this == &other) return *this;
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+      if (get_alloc() != other.get_alloc()) reset();
+      get_alloc() = other.get_alloc();
+    }
+    small_vector tmp(other, get_alloc());
+    swap(tmp);
+    return *this;
+  }
+  // Steals other's heap buffer when this allocator can free it; otherwise
+  // moves the elements one by one into storage of its own.
+  small_vector &operator=(small_vector &&other) noexcept(
+      std::is_nothrow_move_constructible<T>::value &&
+      (alloc_traits::propagate_on_container_move_assignment::value ||
+       alloc_traits::is_always_equal::value)) {
+    if (this == &other) return *this;
+    reset();
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+      get_alloc() = std::move(other.get_alloc());
+      take(other);
+    } else if (get_alloc() == other.get_alloc()) {
+      take(other);
+    } else {
+      take_elements(other);
+    }
+    return *this;
+  }
+
+  // Allocators are exchanged only when they propagate on swap; swapping
+  // two vectors with unequal, non-propagating allocators is undefined, as
+  // for std::vector. Inline elements are moved or swapped one by one, so
+  // this may throw when T's move does.
+  void swap(small_vector &rhs) noexcept(
+      std::is_nothrow_move_constructible<T>::value &&
+      std::is_nothrow_swappable<T>::value) {
+    if (this == &rhs) return;
+    if (!is_inline() && !rhs.is_inline()) {
+      std::swap(data_, rhs.data_);
+      std::swap(sz_, rhs.sz_);
+      std::swap(cap_, rhs.cap_);
+    } else if (!is_inline()) {
+      rhs.swap_inline_with_heap(*this);
+    } else if (!rhs.is_inline()) {
+      swap_inline_with_heap(rhs);
+    } else {
+      small_vector &longer = sz_ < rhs.sz_ ? rhs : *this;
+      small_vector &shorter = sz_ < rhs.sz_ ? *this : rhs;
+      size_t common = shorter.sz_;
+      for (size_t i = 0; i < common; ++i) {
+        using std::swap;
+        swap(data_[i], rhs.data_[i]);
+      }
+      for (; shorter.sz_ < longer.sz_; ++shorter.sz_) {
+        shorter.construct(shorter.data_ + shorter.sz_,
+                          std::move(longer.data_[shorter.sz_]));
+      }
+      while (longer.sz_ > common) longer.pop_back();
+    }
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      std::swap(get_alloc(), rhs.get_alloc());
+    }
+  }
+
+  Alloc get_allocator() const { return get_alloc(); }
+
+  T &at(const size_t &pos) {
+    if (pos >= sz_) throw index_out_of_bound();
+    return data_[pos];
+  }
+  const T &at(const size_t &pos) const {
+    if (pos >= sz_) throw index_out_of_bound();
+    return data_[pos];
+  }
+
+  T &operator[](const size_t &pos) {
+    detail::check_subscript(pos, sz_);
+    return data_[pos];
+  }
+  const T &operator[](const size_t &pos) const {
+    detail::check_subscript(pos, sz_);
+    return data_[pos];
+  }
+
+  const T &front() const {
+    if (sz_ == 0) throw container_is_empty();
+    return data_[0];
+  }
+  const T &back() const {
+    if (sz_ == 0) throw container_is_empty();
+    return data_[sz_ - 1];
+  }
+
+  T *data() { return data_; }
+  const T *data() const { return data_; }
+
+  iterator begin() { return iterator(data_, this); }
+  const_iterator begin() const { return const_iterator(data_, this); }
+  const_iterator cbegin() const { return const_iterator(data_, this); }
+
+  iterator end() { return iterator(data_ + sz_, this); }
+  const_iterator end() const { return const_iterator(data_ + sz_, this); }
+  const_iterator cend() const { return const_iterator(data_ + sz_, this); }
+
+  bool empty() const { return sz_ == 0; }
+  size_t size() const { return sz_; }
+  size_t capacity() const { return cap_; }
+  static constexpr size_t inline_capacity() { return N; }
+  bool is_inline() const { return data_ == inline_data(); }
+
+  void reserve(size_t n) {
+    if (n > cap_) reallocate(n);
+  }
+
+  // Moves back into the inline buffer when the elements fit there.
+  void shrink_to_fit() {
+    if (is_inline() || sz_ == cap_) return;
+    if (sz_ <= N) {
+      relocate(inline_data(), N);
+    } else {
+      reallocate(sz_);
+    }
+  }
+
+  void clear() {
+    for (size_t i = 0; i < sz_; ++i) destroy(data_ + i);
+    sz_ = 0;
+  }
+
+  template <typename... Args>
+  T &emplace_back(Args &&...args) {
+    if (sz_ == cap_) {
+      T value(std::forward<Args>(args)...);
+      ensure_capacity(sz_ + 1);
+      construct(data_ + sz_, std::move(value));
+    } else {
+      construct(data_ + sz_, std::forward<Args>(args)...);
+    }
+    return data_[sz_++];
+  }
+
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  void pop_back() {
+    if (sz_ == 0) throw container_is_empty();
+    --sz_;
+    destroy(data_ + sz_);
+  }
+
+  iterator insert(iterator pos, const T &value) {
+    return insert(index_of(pos), value);
+  }
+  iterator insert(iterator pos, T &&value) {
+    return insert(index_of(pos), std::move(value));
+  }
+
+  iterator insert(const size_t &ind, const T &value) {
+    if (ind > sz_) throw index_out_of_bound();
+    T tmp(value);
+    return insert(ind, std::move(tmp));
+  }
+
+  iterator insert(const size_t &ind, T &&value) {
+    if (ind > sz_) throw index_out_of_bound();
+    if (ind == sz_) {
+      emplace_back(std::move(value));
+      return iterator(data_ + ind, this);
+    }
+    ensure_capacity(sz_ + 1);
+    construct(data_ + sz_, std::move(data_[sz_ - 1]));
+    ++sz_;
+    for (size_t i = sz_ - 2; i > ind; --i) data_[i] = std::move(data_[i - 1]);
+    data_[ind] = std::move(value);
+    return iterator(data_ + ind, this);
+  }
+
+  iterator erase(iterator pos) {
+    if (pos == end()) throw invalid_iterator();
+    return erase(pos, pos + 1);
+  }
+
+  iterator erase(iterator first, iterator last) {
+    size_t lo = index_of(first), hi = index_of(last);
+    if (lo > hi) throw invalid_iterator();
+    size_t k = hi - lo;
+    if (k == 0) return first;
+    for (size_t i = hi; i < sz_; ++i) data_[i - k] = std::move(data_[i]);
+    for (size_t i = sz_ - k; i < sz_; ++i) destroy(data_ + i);
+    sz_ -= k;
+    return first;
+  }
+
+  iterator erase(const size_t &ind) {
+    if (ind >= sz_) throw index_out_of_bound();
+    return erase(iterator(data_ + ind, this));
+  }
+};
+
+}  // namespace sjtu
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef SJTU_SPAN_HPP
+#define SJTU_SPAN_HPP
+
+#include "vector.hpp"
+
+namespace sjtu {
+
+// A non-owning view of size() contiguous elements, cheap to copy and to
+// slice. It can be made from anything with data() and size(): vector,
+// devector, small_vector, a C array or another span. span<const T> views
+// elements read-only. The viewed storage must outlive the span, and a
+// reallocation of the source invalidates it like an iterator.
+template <typename T>
+class span {
+ public:
+  using element_type = T;
+  using value_type = typename std::remove_cv<T>::type;
+  using pointer = T *;
+  using reference = T &;
+  using iterator = T *;
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+ private:
+  T *data_ = nullptr;
+  size_t sz_ = 0;
+
+  template <typename C>
+  using data_element =
+      typename std::remove_pointer<decltype(std::declval<C &>().data())>::type;
+
+ public:
+  constexpr span() noexcept = default;
+  constexpr span(T *p, size_t n) noexcept : data_(p), sz_(n) {}
+  constexpr span(T *first, T *last) noexcept
+      : data_(first), sz_(static_cast<size_t>(last - first)) {}
+  template <size_t N>
+  constexpr span(T (&arr)[N]) noexcept : data_(arr), sz_(N) {}
+  template <typename Container,
+            typename = typename std::enable_if<
+                !std::is_same<typename std::remove_cv<Container>::type,
+                              span>::value &&
+                std::is_convertible<data_element<Container> (*)[],
+                                    T (*)[]>::value>::type>
+  constexpr span(Container &c) noexcept : data_(c.data()), sz_(c.size()) {}
+  template <typename U, typename = typename std::enable_if<
+                            std::is_convertible<U (*)[], T (*)[]>::value>::type>
+  constexpr span(const span<U> &other) noexcept
+      : data_(other.data()), sz_(other.size()) {}
+
+  constexpr T *data() const noexcept { return data_; }
+  constexpr size_t size() const noexcept { return sz_; }
+  constexpr size_t size_bytes() const noexcept { return sz_ * sizeof(T); }
+  constexpr bool empty() const noexcept { return sz_ == 0; }
+
+  constexpr T *begin() const noexcept { return data_; }
+  constexpr T *end() const noexcept { return data_ + sz_; }
+
+  T &operator[](size_t pos) const {
+    detail::check_subscript(pos, sz_);
+    return data_[pos];
+  }
+  T &at(size_t pos) const {
+    if (pos >= sz_) throw index_out_of_bound();
+    return data_[pos];
+  }
+  T &front() const {
+    if (sz_ == 0) throw container_is_empty();
+    return data_[0];
+  }
+  T &back() const {
+    if (sz_ == 0) throw container_is_empty();
+    return data_[sz_ - 1];
+  }
+
+  // The first or last n elements.
+  span first(size_t n) const {
+    if (n > sz_) throw index_out_of_bound();
+    return span(data_, n);
+  }
+  span last(size_t n) const {
+    if (n > sz_) throw index_out_of_bound();
+    return span(data_ + sz_ - n, n);
+  }
+
+  // count elements from offset, or everything after offset when count is
+  // npos.
+  span subspan(size_t offset, size_t count = npos) const {
+    if (offset > sz_) throw index_out_of_bound();
+    if (count == npos) return span(data_ + offset, sz_ - offset);
+    if (count > sz_ - offset) throw index_out_of_bound();
+    return span(data_ + offset, count);
+  }
+};
+
+template <typename T, size_t N>
+span(T (&)[N]) -> span<T>;
+template <typename Container>
+span(Container &) -> span<typename std::remove_pointer<
+    decltype(std::declval<Container &>().data())>::type>;
+
+}  // namespace sjtu
+
+#endif
@@ -0,0 +1,331 @@
+#ifndef SJTU_STABLE_VECTOR_HPP
+#define SJTU_STABLE_VECTOR_HPP
+
+#include "vector.hpp"
+
+namespace sjtu {
+
+namespace detail {
+
+// About 4 KiB of elements per chunk, rounded down to a power of two and
+// never fewer than 16.
+template <typename T>
+constexpr size_t default_chunk_size() {
+  size_t n = 16;
+  while (n * 2 * sizeof(T) <= 4096) n *= 2;
+  return n;
+}
+
+}  // namespace detail
+
+// A sequence stored in fixed-size chunks of Chunk elements, found through
+// a vector of chunk pointers. Growing only adds chunks and may move the
+// pointer vector, never an element, so references, pointers and
+// iterators stay valid across push_back, emplace_back and reserve.
+// insert and erase shift the elements after the position, which
+// invalidates those; pop_back only the last. operator[] is O(1): a shift,
+// a mask and one extra load.
+template <typename T, size_t Chunk = detail::default_chunk_size<T>()>
+class stable_vector {
+  static_assert(Chunk > 0 && (Chunk & (Chunk - 1)) == 0,
+                "stable_vector chunks must hold a power of two elements");
+
+ private:
+  static constexpr size_t shift = __builtin_ctzll(Chunk);
+  static constexpr size_t mask = Chunk - 1;
+  static constexpr bool over_aligned =
+      alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+  vector<T *> chunks_;
+  size_t sz_ = 0;
+
+  static T *allocate_chunk() {
+    if constexpr (over_aligned) {
+      return static_cast<T *>(
+          ::operator new(Chunk * sizeof(T), std::align_val_t(alignof(T))));
+    } else {
+      return static_cast<T *>(::operator new(Chunk * sizeof(T)));
+    }
+  }
+  static void free_chunk(T *p) {
+    if constexpr (over_aligned) {
+      ::operator delete(p, std::align_val_t(alignof(T)));
+    } else {
+      ::operator delete(p);
+    }
+  }
+
+  T *slot(size_t i) const { return chunks_.data()[i >> shift] + (i & mask); }
+
+  // Makes room for one more element by adding a chunk when all are full.
+  void ensure_slot() {
+    if (sz_ < capacity()) return;
+    T *c = allocate_chunk();
+    try {
+      chunks_.push_back(c);
+    } catch (...) {
+      free_chunk(c);
+      throw;
+    }
+  }
+
+  void free_unused_chunks() {
+    size_t keep = (sz_ + mask) >> shift;
+    while (chunks_.size() > keep) {
+      free_chunk(chunks_.back());
+      chunks_.pop_back();
+    }
+  }
+
+  template <bool Const>
+  class basic_iterator {
+   private:
+    using owner_ptr =
+        std::conditional_t<Const, const stable_vector *, stable_vector *>;
+
+    owner_ptr owner_ = nullptr;
+    size_t i_ = 0;
+
+    friend class stable_vector;
+    template <bool>
+    friend class basic_iterator;
+
+    basic_iterator(owner_ptr owner, size_t i) : owner_(owner), i_(i) {}
+
+   public:
+    using value_type = T;
+    using reference = std::conditional_t<Const, const T &, T &>;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::random_access_iterator_tag;
+
+    basic_iterator() = default;
+    // iterator converts to const_iterator.
+    template <bool C, typename = std::enable_if_t<Const && !C>>
+    basic_iterator(const basic_iterator<C> &other)
+        : owner_(other.owner_), i_(other.i_) {}
+
+    reference operator*() const { return *owner_->slot(i_); }
+    pointer operator->() const { return owner_->slot(i_); }
+    reference operator[](difference_type n) const {
+      return *owner_->slot(i_ + n);
+    }
+
+    basic_iterator &operator++() {
+      ++i_;
+      return *this;
+    }
+    basic_iterator operator++(int) { return basic_iterator(owner_, i_++); }
+    basic_iterator &operator--() {
+      --i_;
+      return *this;
+    }
+    basic_iterator operator--(int) { return basic_iterator(owner_, i_--); }
+    basic_iterator &operator+=(difference_type n) {
+      i_ += n;
+      return *this;
+    }
+    basic_iterator &operator-=(difference_type n) {
+      i_ -= n;
+      return *this;
+    }
+    basic_iterator operator+(difference_type n) const {
+      return basic_iterator(owner_, i_ + n);
+    }
+    basic_iterator operator-(difference_type n) const {
+      return basic_iterator(owner_, i_ - n);
+    }
+    friend basic_iterator operator+(difference_type n,
+                                    const basic_iterator &it) {
+      return it + n;
+    }
+    // Iterators into different containers cannot be subtracted.
+    difference_type operator-(const basic_iterator &rhs) const {
+      if (owner_ != rhs.owner_) throw invalid_iterator();
+      return difference_type(i_) - difference_type(rhs.i_);
+    }
+
+    bool operator==(const basic_iterator &rhs) const {
+      return owner_ == rhs.owner_ && i_ == rhs.i_;
+    }
+    bool operator!=(const basic_iterator &rhs) const { return !(*this == rhs); }
+    bool operator<(const basic_iterator &rhs) const { return i_ < rhs.i_; }
+    bool operator>(const basic_iterator &rhs) const { return i_ > rhs.i_; }
+    bool operator<=(const basic_iterator &rhs) const { return i_ <= rhs.i_; }
+    bool operator>=(const basic_iterator &rhs) const { return i_ >= rhs.i_; }
+  };
+
+  template <typename It>
+  size_t index_of(const It &pos) const {
+    if (pos.owner_ != this || pos.i_ > sz_) throw invalid_iterator();
+    return pos.i_;
+  }
+
+ public:
+  using value_type = T;
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  stable_vector() = default;
+  stable_vector(const stable_vector &other) {
+    reserve(other.sz_);
+    try {
+      for (size_t i = 0; i < other.sz_; ++i) emplace_back(*other.slot(i));
+    } catch (...) {
+      clear();
+      free_unused_chunks();
+      throw;
+    }
+  }
+  stable_vector(stable_vector &&other) noexcept
+      : chunks_(std::move(other.chunks_)), sz_(other.sz_) {
+    other.sz_ = 0;
+  }
+  stable_vector(std::initializer_list<T> il) {
+    reserve(il.size());
+    try {
+      for (const T &x : il) emplace_back(x);
+    } catch (...) {
+      clear();
+      free_unused_chunks();
+      throw;
+    }
+  }
+  ~stable_vector() {
+    clear();
+    for (size_t c = 0; c < chunks_.size(); ++c) free_chunk(chunks_[c]);
+  }
+
+  stable_vector &operator=(const stable_vector &other) {
+    if (this == &other) return *this;
+    stable_vector tmp(other);
+    swap(tmp);
+    return *this;
+  }
+  stable_vector &operator=(stable_vector &&other) noexcept {
+    if (this == &other) return *this;
+    stable_vector tmp(std::move(other));
+    swap(tmp);
+    return *this;
+  }
+
+  void swap(stable_vector &rhs) noexcept {
+    chunks_.swap(rhs.chunks_);
+    std::swap(sz_, rhs.sz_);
+  }
+
+  T &at(const size_t &pos) {
+    if (pos >= sz_) throw index_out_of_bound();
+    return *slot(pos);
+  }
+  const T &at(const size_t &pos) const {
+    if (pos >= sz_) throw index_out_of_bound();
+    return *slot(pos);
+  }
+
+  T &operator[](const size_t &pos) {
+    detail::check_subscript(pos, sz_);
+    return *slot(pos);
+  }
+  const T &operator[](const size_t &pos) const {
+    detail::check_subscript(pos, sz_);
+    return *slot(pos);
+  }
+
+  const T &front() const {
+    if (sz_ == 0) throw container_is_empty();
+    return *slot(0);
+  }
+  const T &back() const {
+    if (sz_ == 0) throw container_is_empty();
+    return *slot(sz_ - 1);
+  }
+
+  iterator begin() { return iterator(this, 0); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator cbegin() const { return const_iterator(this, 0); }
+  iterator end() { return iterator(this, sz_); }
+  const_iterator end() const { return const_iterator(this, sz_); }
+  const_iterator cend() const { return const_iterator(this, sz_); }
+
+  bool empty() const { return sz_ == 0; }
+  size_t size() const { return sz_; }
+  size_t capacity() const { return chunks_.size() << shift; }
+  static constexpr size_t chunk_size() { return Chunk; }
+
+  // Allocates the chunks for n elements up front.
+  void reserve(size_t n) {
+    size_t need = (n + mask) >> shift;
+    if (need <= chunks_.size()) return;
+    chunks_.reserve(need);
+    while (chunks_.size() < need) chunks_.push_back(allocate_chunk());
+  }
+
+  // Frees the chunks past the last element.
+  void shrink_to_fit() { free_unused_chunks(); }
+
+  // Destroys the elements; the chunks are kept for reuse.
+  void clear() {
+    for (size_t i = 0; i < sz_; ++i) slot(i)->~T();
+    sz_ = 0;
+  }
+
+  template <typename... Args>
+  T &emplace_back(Args &&...args) {
+    ensure_slot();
+    T *p = slot(sz_);
+    new (p) T(std::forward<Args>(args)...);
+    ++sz_;
+    return *p;
+  }
+
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  void pop_back() {
+    if (sz_ == 0) throw container_is_empty();
+    --sz_;
+    slot(sz_)->~T();
+  }
+
+  iterator insert(iterator pos, const T &value) {
+    return insert(index_of(pos), value);
+  }
+
+  iterator insert(const size_t &ind, const T &value) {
+    if (ind > sz_) throw index_out_of_bound();
+    T tmp(value);
+    return insert(ind, std::move(tmp));
+  }
+
+  // Moves the elements from ind on back by one; they change address.
+  iterator insert(const size_t &ind, T &&value) {
+    if (ind > sz_) throw index_out_of_bound();
+    if (ind == sz_) {
+      emplace_back(std::move(value));
+      return iterator(this, ind);
+    }
+    emplace_back(std::move(*slot(sz_ - 1)));
+    for (size_t i = sz_ - 2; i > ind; --i) *slot(i) = std::move(*slot(i - 1));
+    *slot(ind) = std::move(value);
+    return iterator(this, ind);
+  }
+
+  iterator erase(iterator pos) {
+    size_t ind = index_of(pos);
+    if (ind == sz_) throw invalid_iterator();
+    return erase(ind);
+  }
+
+  // Moves the elements after ind forward by one; they change address.
+  iterator erase(const size_t &ind) {
+    if (ind >= sz_) throw index_out_of_bound();
+    for (size_t i = ind; i + 1 < sz_; ++i) *slot(i) = std::move(*slot(i + 1));
+    pop_back();
+    return iterator(this, ind);
+  }
+};
+
+}  // namespace sjtu
+
+#endif
@@ -5,312 +5,1127 @@
 
 #include <climits>
 #include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Defining SJTU_VECTOR_UNCHECKED removes the bounds checks from operator[]
+// and from iterator use, for builds that trust their indices; at() keeps
+// checking either way. SJTU_VECTOR_UNCHECKED_ITERATORS alone only affects
+// iterators.
+#if defined(SJTU_VECTOR_UNCHECKED) && !defined(SJTU_VECTOR_UNCHECKED_ITERATORS)
+#define SJTU_VECTOR_UNCHECKED_ITERATORS
+#endif
+
+// Under C++20 vector is usable in constant expressions: SJTU_CONSTEXPR20
+// marks what becomes constexpr, and SJTU_CONSTANT_EVALUATED() steers the
+// allocator and the bitwise fast paths away from malloc and memcpy, which
+// constant evaluation does not allow.
+#if __cplusplus >= 202002L && defined(__cpp_constexpr_dynamic_alloc)
+#define SJTU_CONSTEXPR20 constexpr
+#define SJTU_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#else
+#define SJTU_CONSTEXPR20
+#define SJTU_CONSTANT_EVALUATED() false
+#endif
 
 namespace sjtu {
 
+// Growth policies pick the capacity of the next buffer. A policy provides
+//   static size_t grow(size_t cap, size_t need, size_t elem_size);
+//   static size_t shrink(size_t size, size_t cap);
+// grow returns at least need; shrink runs after every removal and returns
+// the capacity to shrink to, or cap to keep the current buffer.
+namespace growth {
+
+struct doubling {
+  static constexpr size_t grow(size_t cap, size_t need, size_t) {
+    size_t ncap = cap ? cap : 1;
+    while (ncap < need) ncap <<= 1;
+    return ncap;
+  }
+  static constexpr size_t shrink(size_t, size_t cap) { return cap; }
+};
+
+struct one_and_half {
+  static constexpr size_t grow(size_t cap, size_t need, size_t) {
+    size_t ncap = cap ? cap : 1;
+    while (ncap < need) ncap += ncap / 2 + 1;
+    return ncap;
+  }
+  static constexpr size_t shrink(size_t, size_t cap) { return cap; }
+};
+
+// Steps through 1, 2, 3, 5, 8, ..., a growth factor tending to 1.618.
+struct fibonacci {
+  static constexpr size_t grow(size_t cap, size_t need, size_t) {
+    size_t a = 1, b = 2;
+    while (a <= cap || a < need) {
+      size_t c = a + b;
+      a = b;
+      b = c;
+    }
+    return a;
+  }
+  static constexpr size_t shrink(size_t, size_t cap) { return cap; }
+};
+
+// Doubles, then rounds the buffer up to whole pages so no allocation ends
+// in a partly used page.
+template <size_t PageBytes = 4096>
+struct page_granular {
+  static constexpr size_t grow(size_t cap, size_t need, size_t elem_size) {
+    size_t ncap = doubling::grow(cap, need, elem_size);
+    size_t bytes = (ncap * elem_size + PageBytes - 1) / PageBytes * PageBytes;
+    return bytes / elem_size;
+  }
+  static constexpr size_t shrink(size_t, size_t cap) { return cap; }
+};
+
+// Adds shrinking to Base. The buffer halves only once size falls to a
+// quarter of it, so after a shrink or a growth the size has to double or
+// halve before the next reallocation, and push/pop traffic hovering
+// around a boundary reallocates at most once.
+template <typename Base = doubling>
+struct shrink_with_hysteresis : Base {
+  static constexpr size_t shrink(size_t size, size_t cap) {
+    size_t ncap = cap;
+    while (ncap >= 4 && size <= ncap / 4) ncap /= 2;
+    return ncap;
+  }
+};
+
+}  // namespace growth
+
+// The default allocator. Trivially copyable elements are served from
+// malloc, so it can also offer
+//   T *reallocate(T *p, size_t old_n, size_t new_n);
+// which vector uses, when an allocator has it, to grow trivially copyable
+// elements in place (glibc remaps large blocks instead of copying them).
+// reallocate keeps the first min(old_n, new_n) elements bytewise and
+// leaves p untouched if it throws.
 template <typename T>
-class vector {
+class allocator {
+  static constexpr bool malloc_backed =
+      std::is_trivially_copyable<T>::value &&
+      alignof(T) <= alignof(std::max_align_t);
+  static constexpr bool over_aligned =
+      alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+  template <typename U>
+  friend class allocator;
+
+ public:
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  constexpr allocator() = default;
+  template <typename U>
+  constexpr allocator(const allocator<U> &) noexcept {}
+
+  SJTU_CONSTEXPR20 T *allocate(size_t n) {
+    if (SJTU_CONSTANT_EVALUATED()) return std::allocator<T>().allocate(n);
+    if constexpr (malloc_backed) {
+      void *p = std::malloc(n * sizeof(T));
+      if (p == nullptr) throw std::bad_alloc();
+      return static_cast<T *>(p);
+    } else if constexpr (over_aligned) {
+      return static_cast<T *>(
+          ::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    } else {
+      return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+  }
+  SJTU_CONSTEXPR20 void deallocate(T *p, size_t n) noexcept {
+    if (SJTU_CONSTANT_EVALUATED()) return std::allocator<T>().deallocate(p, n);
+    if constexpr (malloc_backed) {
+      std::free(p);
+    } else if constexpr (over_aligned) {
+      ::operator delete(p, std::align_val_t(alignof(T)));
+    } else {
+      ::operator delete(p);
+    }
+  }
+  template <typename U = T,
+            typename = typename std::enable_if<allocator<U>::malloc_backed>::type>
+  T *reallocate(T *p, size_t, size_t n) {
+    void *np = std::realloc(p, n * sizeof(T));
+    if (np == nullptr) throw std::bad_alloc();
+    return static_cast<T *>(np);
+  }
+};
+
+template <typename T, typename U>
+constexpr bool operator==(const allocator<T> &, const allocator<U> &) {
+  return true;
+}
+template <typename T, typename U>
+constexpr bool operator!=(const allocator<T> &, const allocator<U> &) {
+  return false;
+}
+
+namespace detail {
+
+template <typename Alloc, typename T, typename = void>
+struct has_reallocate : std::false_type {};
+template <typename Alloc, typename T>
+struct has_reallocate<
+    Alloc, T,
+    decltype((void)std::declval<Alloc &>().reallocate(
+        std::declval<T *>(), size_t(), size_t()))> : std::true_type {};
+
+// Keeps a stateless allocator as an empty base so it adds nothing to the
+// size of the container.
+template <typename Alloc, bool = std::is_empty<Alloc>::value &&
+                                 !std::is_final<Alloc>::value>
+class alloc_holder : private Alloc {
+ public:
+  constexpr alloc_holder() = default;
+  constexpr explicit alloc_holder(const Alloc &a) : Alloc(a) {}
+  constexpr explicit alloc_holder(Alloc &&a) : Alloc(std::move(a)) {}
+  constexpr Alloc &get_alloc() noexcept { return *this; }
+  constexpr const Alloc &get_alloc() const noexcept { return *this; }
+};
+
+template <typename Alloc>
+class alloc_holder<Alloc, false> {
+  Alloc alloc_;
+
+ public:
+  constexpr alloc_holder() = default;
+  constexpr explicit alloc_holder(const Alloc &a) : alloc_(a) {}
+  constexpr explicit alloc_holder(Alloc &&a) : alloc_(std::move(a)) {}
+  constexpr Alloc &get_alloc() noexcept { return alloc_; }
+  constexpr const Alloc &get_alloc() const noexcept { return alloc_; }
+};
+
+// Random-access iterator over contiguous storage; T is const-qualified for
+// const_iterator. By default it also records its container, so
+// dereferencing outside [begin(), end()) or subtracting iterators of two
+// containers throws invalid_iterator. With SJTU_VECTOR_UNCHECKED_ITERATORS
+// defined it is a bare pointer, and loops over it optimize like pointer
+// loops. Container must provide a private holds(const value_type *).
+template <typename Container, typename T>
+class contiguous_iterator {
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus >= 202002L
+  using iterator_concept = std::contiguous_iterator_tag;
+#endif
+  using value_type = typename std::remove_cv<T>::type;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T *;
+  using reference = T &;
+
  private:
+  T *ptr_ = nullptr;
+#ifndef SJTU_VECTOR_UNCHECKED_ITERATORS
+  const Container *owner_ = nullptr;
+#endif
+
+  friend Container;
+  template <typename, typename>
+  friend class contiguous_iterator;
+
+  constexpr bool belongs_to(const Container *c) const {
+#ifndef SJTU_VECTOR_UNCHECKED_ITERATORS
+    return owner_ == c;
+#else
+    (void)c;
+    return true;
+#endif
+  }
+
+  constexpr void check() const {
+#ifndef SJTU_VECTOR_UNCHECKED_ITERATORS
+    if (owner_ == nullptr || !owner_->holds(ptr_)) throw invalid_iterator();
+#endif
+  }
+
+ public:
+  constexpr contiguous_iterator() = default;
+  constexpr contiguous_iterator(T *p, const Container *owner) : ptr_(p) {
+#ifndef SJTU_VECTOR_UNCHECKED_ITERATORS
+    owner_ = owner;
+#else
+    (void)owner;
+#endif
+  }
+  template <typename U, typename = typename std::enable_if<
+                            std::is_same<const U, T>::value &&
+                            !std::is_same<U, T>::value>::type>
+  constexpr contiguous_iterator(const contiguous_iterator<Container, U> &other)
+      : ptr_(other.ptr_) {
+#ifndef SJTU_VECTOR_UNCHECKED_ITERATORS
+    owner_ = other.owner_;
+#endif
+  }
+
+  constexpr reference operator*() const {
+    check();
+    return *ptr_;
+  }
+  constexpr pointer operator->() const {
+    check();
+    return ptr_;
+  }
+  constexpr reference operator[](difference_type n) const {
+    return *(*this + n);
+  }
+
+  constexpr contiguous_iterator &operator++() {
+    ++ptr_;
+    return *this;
+  }
+  constexpr contiguous_iterator operator++(int) {
+    contiguous_iterator tmp = *this;
+    ++ptr_;
+    return tmp;
+  }
+  constexpr contiguous_iterator &operator--() {
+    --ptr_;
+    return *this;
+  }
+  constexpr contiguous_iterator operator--(int) {
+    contiguous_iterator tmp = *this;
+    --ptr_;
+    return tmp;
+  }
+  constexpr contiguous_iterator &operator+=(difference_type n) {
+    ptr_ += n;
+    return *this;
+  }
+  constexpr contiguous_iterator &operator-=(difference_type n) {
+    ptr_ -= n;
+    return *this;
+  }
+  constexpr contiguous_iterator operator+(difference_type n) const {
+    contiguous_iterator tmp = *this;
+    return tmp += n;
+  }
+  constexpr contiguous_iterator operator-(difference_type n) const {
+    contiguous_iterator tmp = *this;
+    return tmp -= n;
+  }
+  friend constexpr contiguous_iterator operator+(difference_type n,
+                                       const contiguous_iterator &it) {
+    return it + n;
+  }
+
+  template <typename U>
+  constexpr difference_type operator-(
+      const contiguous_iterator<Container, U> &rhs) const {
+#ifndef SJTU_VECTOR_UNCHECKED_ITERATORS
+    if (owner_ != rhs.owner_) throw invalid_iterator();
+#endif
+    return ptr_ - rhs.ptr_;
+  }
+
+  template <typename U>
+  constexpr bool operator==(
+      const contiguous_iterator<Container, U> &rhs) const {
+    return ptr_ == rhs.ptr_;
+  }
+  template <typename U>
+  constexpr bool operator!=(
+      const contiguous_iterator<Container, U> &rhs) const {
+    return ptr_ != rhs.ptr_;
+  }
+  template <typename U>
+  constexpr bool operator<(
+      const contiguous_iterator<Container, U> &rhs) const {
+    return ptr_ < rhs.ptr_;
+  }
+  template <typename U>
+  constexpr bool operator>(
+      const contiguous_iterator<Container, U> &rhs) const {
+    return ptr_ > rhs.ptr_;
+  }
+  template <typename U>
+  constexpr bool operator<=(
+      const contiguous_iterator<Container, U> &rhs) const {
+    return ptr_ <= rhs.ptr_;
+  }
+  template <typename U>
+  constexpr bool operator>=(
+      const contiguous_iterator<Container, U> &rhs) const {
+    return ptr_ >= rhs.ptr_;
+  }
+};
+
+// The operator[] check, compiled out under SJTU_VECTOR_UNCHECKED.
+constexpr void check_subscript(size_t pos, size_t size) {
+#ifndef SJTU_VECTOR_UNCHECKED
+  if (pos >= size) throw index_out_of_bound();
+#else
+  (void)pos;
+  (void)size;
+#endif
+}
+
+}  // namespace detail
+
+// Storage comes from Alloc through std::allocator_traits; elements are
+// built and destroyed with its construct and destroy. Trivially copyable
+// elements are relocated bitwise rather than through the allocator.
+template <typename T, typename Alloc = allocator<T>,
+          typename Growth = growth::doubling>
+class vector : private detail::alloc_holder<Alloc> {
+ private:
+  using alloc_traits = std::allocator_traits<Alloc>;
+  using holder = detail::alloc_holder<Alloc>;
+  using holder::get_alloc;
+  static_assert(std::is_same<typename alloc_traits::pointer, T *>::value,
+                "sjtu::vector requires an allocator with raw pointers");
+
   T *data_ = nullptr;
   size_t sz_ = 0;
   size_t cap_ = 0;
 
-  static T *raw_alloc(size_t n) { return (T *)::operator new(n * sizeof(T)); }
-  static void raw_free(T *p) { ::operator delete(p); }
+  static constexpr bool trivially_relocatable =
+      std::is_trivially_copyable<T>::value;
+  static constexpr bool in_place_growth =
+      trivially_relocatable && detail::has_reallocate<Alloc, T>::value;
+  // The bitwise paths below are taken only when not constant evaluated.
 
-  void ensure_capacity(size_t need) {
-    if (need <= cap_) return;
-    size_t ncap = cap_ ? cap_ : 1;
-    while (ncap < need) ncap <<= 1;
-    T *nd = raw_alloc(ncap);
-    size_t i = 0;
+  SJTU_CONSTEXPR20 T *raw_alloc(size_t n) {
+    return alloc_traits::allocate(get_alloc(), n);
+  }
+  SJTU_CONSTEXPR20 void raw_free(T *p, size_t n) {
+    if (p != nullptr) alloc_traits::deallocate(get_alloc(), p, n);
+  }
+  template <typename... Args>
+  SJTU_CONSTEXPR20 void construct(T *p, Args &&...args) {
+    alloc_traits::construct(get_alloc(), p, std::forward<Args>(args)...);
+  }
+  SJTU_CONSTEXPR20 void destroy(T *p) { alloc_traits::destroy(get_alloc(), p); }
+
+  // Drops every element and the buffer.
+  SJTU_CONSTEXPR20 void release() {
+    destroy_from(0);
+    raw_free(data_, cap_);
+    data_ = nullptr;
+    cap_ = 0;
+  }
+
+  SJTU_CONSTEXPR20 void steal(vector &other) {
+    data_ = other.data_;
+    sz_ = other.sz_;
+    cap_ = other.cap_;
+    other.data_ = nullptr;
+    other.sz_ = 0;
+    other.cap_ = 0;
+  }
+
+  SJTU_CONSTEXPR20 void swap_storage(vector &rhs) noexcept {
+    std::swap(data_, rhs.data_);
+    std::swap(sz_, rhs.sz_);
+    std::swap(cap_, rhs.cap_);
+  }
+
+  // Builds copies of [first, first + n) into an empty vector, with one
+  // memcpy when first is a pointer to trivially copyable elements.
+  template <typename ForwardIt>
+  SJTU_CONSTEXPR20 void init_from(ForwardIt first, size_t n) {
+    if (n == 0) return;
+    data_ = raw_alloc(n);
+    cap_ = n;
+    using source = typename std::remove_cv<
+        typename std::remove_pointer<ForwardIt>::type>::type;
+    if constexpr (trivially_relocatable && std::is_pointer<ForwardIt>::value &&
+                  std::is_same<source, T>::value) {
+      if (!SJTU_CONSTANT_EVALUATED()) {
+        std::memcpy(data_, first, n * sizeof(T));
+        sz_ = n;
+        return;
+      }
+    }
     try {
-      for (; i < sz_; ++i) new (nd + i) T(data_[i]);
+      for (; sz_ < n; ++sz_, ++first) construct(data_ + sz_, *first);
     } catch (...) {
-      for (size_t j = 0; j < i; ++j) nd[j].~T();
-      raw_free(nd);
+      release();
       throw;
     }
-    for (size_t j = 0; j < sz_; ++j) data_[j].~T();
-    raw_free(data_);
-    data_ = nd;
-    cap_ = ncap;
   }
 
- public:
-  class const_iterator;
-  class iterator {
-   public:
-    using difference_type = std::ptrdiff_t;
-    using value_type = T;
-    using pointer = T *;
-    using reference = T &;
-    using iterator_category = std::output_iterator_tag;
-
-   private:
-    const vector *owner = nullptr;
-    size_t idx = 0;
-    friend class vector;
-    friend class const_iterator;
-
-   public:
-    iterator() = default;
-    iterator(const vector *o, size_t i) : owner(o), idx(i) {}
-
-    iterator operator+(const int &n) const { return iterator(owner, idx + n); }
-    iterator operator-(const int &n) const { return iterator(owner, idx - n); }
-    int operator-(const iterator &rhs) const {
-      if (owner != rhs.owner) throw invalid_iterator();
-      return static_cast<int>(idx) - static_cast<int>(rhs.idx);
-    }
-    iterator &operator+=(const int &n) {
-      idx += n;
-      return *this;
-    }
-    iterator &operator-=(const int &n) {
-      idx -= n;
-      return *this;
-    }
-    iterator operator++(int) {
-      iterator tmp = *this;
-      ++(*this);
-      return tmp;
-    }
-    iterator &operator++() {
-      ++idx;
-      return *this;
-    }
-    iterator operator--(int) {
-      iterator tmp = *this;
-      --(*this);
-      return tmp;
-    }
-    iterator &operator--() {
-      --idx;
-      return *this;
-    }
-    T &operator*() const {
-      if (owner == nullptr || idx >= owner->sz_) throw invalid_iterator();
-      return const_cast<T &>(owner->data_[idx]);
-    }
-    bool operator==(const iterator &rhs) const {
-      return owner == rhs.owner && idx == rhs.idx;
-    }
-    bool operator==(const const_iterator &rhs) const {
-      return owner == rhs.owner && idx == rhs.idx;
-    }
-    bool operator!=(const iterator &rhs) const { return !(*this == rhs); }
-    bool operator!=(const const_iterator &rhs) const { return !(*this == rhs); }
-  };
+  // Builds n copies of value into an empty vector; a single memset does
+  // it when every byte of a trivially copyable value is the same.
+  SJTU_CONSTEXPR20 void init_fill(size_t n, const T &value) {
+    if constexpr (trivially_relocatable) {
+      const unsigned char *bytes = nullptr;
+      bool uniform = !SJTU_CONSTANT_EVALUATED() && n != 0;
+      if (uniform) bytes = reinterpret_cast<const unsigned char *>(&value);
+      for (size_t i = 1; uniform && i < sizeof(T); ++i) {
+        uniform = bytes[i] == bytes[0];
+      }
+      if (uniform) {
+        data_ = raw_alloc(n);
+        cap_ = n;
+        std::memset(static_cast<void *>(data_), bytes[0], n * sizeof(T));
+        sz_ = n;
+        return;
+      }
+    }
+    init_from(repeat_iterator{&value}, n);
+  }
 
-  class const_iterator {
-   public:
-    using difference_type = std::ptrdiff_t;
-    using value_type = T;
-    using pointer = const T *;
-    using reference = const T &;
-    using iterator_category = std::output_iterator_tag;
+  SJTU_CONSTEXPR20 size_t grown_capacity(size_t need) const {
+    return Growth::grow(cap_, need, sizeof(T));
+  }
+
+  // Moves the live elements into nd, or copies them when T's move may
+  // throw, so a failure leaves *this untouched and nd empty. Elements from
+  // pos on land gap slots further along, leaving room for an insertion.
+  SJTU_CONSTEXPR20 void transfer_to(T *nd, size_t pos = 0, size_t gap = 0) {
+    bool moved = false;
+    if constexpr (trivially_relocatable) {
+      if (!SJTU_CONSTANT_EVALUATED()) {
+        if (sz_ != 0) {
+          std::memcpy(nd, data_, pos * sizeof(T));
+          std::memcpy(nd + pos + gap, data_ + pos, (sz_ - pos) * sizeof(T));
+        }
+        moved = true;
+      }
+    }
+    if (!moved) {
+      size_t i = 0;
+      try {
+        for (; i < sz_; ++i) {
+          construct(nd + (i < pos ? i : i + gap),
+                    std::move_if_noexcept(data_[i]));
+        }
+      } catch (...) {
+        for (size_t j = 0; j < i; ++j) destroy(nd + (j < pos ? j : j + gap));
+        throw;
+      }
+      for (size_t j = 0; j < sz_; ++j) destroy(data_ + j);
+    }
+    raw_free(data_, cap_);
+    data_ = nd;
+  }
 
-   private:
-    const vector *owner = nullptr;
-    size_t idx = 0;
-    friend class vector;
-    friend class iterator;
+  // Requires ncap >= sz_.
+  SJTU_CONSTEXPR20 void reallocate(size_t ncap) {
+    if constexpr (in_place_growth) {
+      if (!SJTU_CONSTANT_EVALUATED()) {
+        if (ncap == 0) {
+          raw_free(data_, cap_);
+          data_ = nullptr;
+        } else {
+          data_ = get_alloc().reallocate(data_, cap_, ncap);
+        }
+        cap_ = ncap;
+        return;
+      }
+    }
+    T *nd = ncap ? raw_alloc(ncap) : nullptr;
+    try {
+      transfer_to(nd);
+    } catch (...) {
+      raw_free(nd, ncap);
+      throw;
+    }
+    cap_ = ncap;
+  }
 
-   public:
-    const_iterator() = default;
-    const_iterator(const vector *o, size_t i) : owner(o), idx(i) {}
-    const_iterator(const iterator &it) : owner(it.owner), idx(it.idx) {}
+  SJTU_CONSTEXPR20 void ensure_capacity(size_t need) {
+    if (need > cap_) reallocate(grown_capacity(need));
+  }
 
-    const_iterator operator+(const int &n) const {
-      return const_iterator(owner, idx + n);
+  // Builds the new element straight into the gap at ind of a larger buffer
+  // before the old one is released, so args may refer to elements of *this.
+  // In-place growth may release the old block itself, so that path builds
+  // the value aside first.
+  template <typename... Args>
+  SJTU_CONSTEXPR20 void grow_emplace(size_t ind, Args &&...args) {
+    if constexpr (in_place_growth) {
+      if (!SJTU_CONSTANT_EVALUATED()) {
+        T value(std::forward<Args>(args)...);
+        reallocate(grown_capacity(sz_ + 1));
+        std::memmove(data_ + ind + 1, data_ + ind, (sz_ - ind) * sizeof(T));
+        construct(data_ + ind, value);
+        ++sz_;
+        return;
+      }
     }
-    const_iterator operator-(const int &n) const {
-      return const_iterator(owner, idx - n);
+    size_t ncap = grown_capacity(sz_ + 1);
+    T *nd = raw_alloc(ncap);
+    try {
+      construct(nd + ind, std::forward<Args>(args)...);
+    } catch (...) {
+      raw_free(nd, ncap);
+      throw;
     }
-    int operator-(const const_iterator &rhs) const {
-      if (owner != rhs.owner) throw invalid_iterator();
-      return static_cast<int>(idx) - static_cast<int>(rhs.idx);
+    try {
+      transfer_to(nd, ind, 1);
+    } catch (...) {
+      destroy(nd + ind);
+      raw_free(nd, ncap);
+      throw;
     }
-    const_iterator &operator+=(const int &n) {
-      idx += n;
-      return *this;
+    cap_ = ncap;
+    ++sz_;
+  }
+
+  // Requires ind < sz_ < cap_.
+  SJTU_CONSTEXPR20 void shift_in(size_t ind, T &&value) {
+    if constexpr (trivially_relocatable) {
+      if (!SJTU_CONSTANT_EVALUATED()) {
+        std::memmove(data_ + ind + 1, data_ + ind, (sz_ - ind) * sizeof(T));
+        construct(data_ + ind, value);
+        ++sz_;
+        return;
+      }
     }
-    const_iterator &operator-=(const int &n) {
-      idx -= n;
-      return *this;
+    construct(data_ + sz_, std::move(data_[sz_ - 1]));
+    ++sz_;
+    for (size_t i = sz_ - 2; i > ind; --i) {
+      data_[i] = std::move(data_[i - 1]);
     }
-    const_iterator operator++(int) {
-      const_iterator tmp = *this;
-      ++(*this);
-      return tmp;
+    data_[ind] = std::move(value);
+  }
+
+  template <typename, typename>
+  friend class detail::contiguous_iterator;
+
+  SJTU_CONSTEXPR20 bool holds(const T *p) const {
+    return p >= data_ && p < data_ + sz_;
+  }
+
+  // Index of pos in this vector; throws invalid_iterator when pos belongs
+  // to another container or lies outside [begin(), end()].
+  template <typename It>
+  SJTU_CONSTEXPR20 size_t index_of(const It &pos) const {
+    if (!pos.belongs_to(this) || pos.ptr_ < data_ || pos.ptr_ > data_ + sz_) {
+      throw invalid_iterator();
     }
-    const_iterator &operator++() {
-      ++idx;
-      return *this;
+    return pos.ptr_ - data_;
+  }
+
+  SJTU_CONSTEXPR20 void destroy_from(size_t n) {
+    for (size_t i = n; i < sz_; ++i) destroy(data_ + i);
+    if (n < sz_) sz_ = n;
+  }
+
+  // Shrinking is only an optimization, so a failed reallocation keeps the
+  // larger buffer rather than failing the removal.
+  SJTU_CONSTEXPR20 void maybe_shrink() {
+    size_t ncap = Growth::shrink(sz_, cap_);
+    if (ncap >= cap_) return;
+    try {
+      reallocate(ncap < sz_ ? sz_ : ncap);
+    } catch (...) {
     }
-    const_iterator operator--(int) {
-      const_iterator tmp = *this;
-      --(*this);
-      return tmp;
+  }
+
+  // Yields the same value forever; lets count-insert share insert_n.
+  struct repeat_iterator {
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = const T *;
+    using reference = const T &;
+    using iterator_category = std::forward_iterator_tag;
+
+    const T *value;
+    constexpr const T &operator*() const { return *value; }
+    constexpr repeat_iterator &operator++() { return *this; }
+  };
+
+  // Inserts the k elements starting at first before ind, with at most one
+  // regrowth and a single shift of the tail. Regrowth keeps the strong
+  // guarantee; an exception during an in-place shift leaves the vector
+  // valid but with unspecified contents past ind.
+  template <typename ForwardIt>
+  SJTU_CONSTEXPR20 void insert_n(size_t ind, ForwardIt first, size_t k) {
+    if (k == 0) return;
+    if constexpr (trivially_relocatable) {
+      if (!SJTU_CONSTANT_EVALUATED()) {
+        ensure_capacity(sz_ + k);
+        std::memmove(data_ + ind + k, data_ + ind, (sz_ - ind) * sizeof(T));
+        size_t i = 0;
+        try {
+          for (; i < k; ++i, ++first) construct(data_ + ind + i, *first);
+        } catch (...) {
+          std::memmove(data_ + ind, data_ + ind + k, (sz_ - ind) * sizeof(T));
+          throw;
+        }
+        sz_ += k;
+        return;
+      }
     }
-    const_iterator &operator--() {
-      --idx;
-      return *this;
+    if (sz_ + k > cap_) {
+      size_t ncap = grown_capacity(sz_ + k);
+      T *nd = raw_alloc(ncap);
+      size_t i = 0;
+      try {
+        for (; i < k; ++i, ++first) construct(nd + ind + i, *first);
+        transfer_to(nd, ind, k);
+      } catch (...) {
+        for (size_t j = 0; j < i; ++j) destroy(nd + ind + j);
+        raw_free(nd, ncap);
+        throw;
+      }
+      cap_ = ncap;
+      sz_ += k;
+    } else {
+      size_t old = sz_;
+      if (k <= old - ind) {
+        for (size_t i = old - k; i < old; ++i, ++sz_) {
+          construct(data_ + i + k, std::move(data_[i]));
+        }
+        for (size_t i = old - k; i-- > ind;) data_[i + k] = std::move(data_[i]);
+        for (size_t i = ind; i < ind + k; ++i, ++first) data_[i] = *first;
+      } else {
+        ForwardIt mid = first;
+        for (size_t i = ind; i < old; ++i) ++mid;
+        for (size_t i = old; i < ind + k; ++i, ++mid, ++sz_) {
+          construct(data_ + i, *mid);
+        }
+        for (size_t i = ind; i < old; ++i, ++sz_) {
+          construct(data_ + i + k, std::move(data_[i]));
+        }
+        for (size_t i = ind; i < old; ++i, ++first) data_[i] = *first;
+      }
+    }
+  }
+
+  // Constructs elements from args at the end until size() is n. If one
+  // throws, the ones already added are destroyed again.
+  template <typename... Args>
+  SJTU_CONSTEXPR20 void grow_to(size_t n, const Args &...args) {
+    ensure_capacity(n);
+    size_t old = sz_;
+    try {
+      for (; sz_ < n; ++sz_) construct(data_ + sz_, args...);
+    } catch (...) {
+      destroy_from(old);
+      throw;
     }
-    const T &operator*() const {
-      if (owner == nullptr || idx >= owner->sz_) throw invalid_iterator();
-      return owner->data_[idx];
+  }
+
+  // Replaces the contents with the k elements from first. When k exceeds
+  // the capacity, a new buffer is filled first and swapped in, so a failed
+  // copy leaves the old contents intact. Otherwise the buffer is reused:
+  // live slots are assigned over and only the difference is constructed
+  // or destroyed, so a throwing copy leaves a valid vector holding a mix
+  // of old and new elements (the basic guarantee only).
+  template <typename ForwardIt>
+  SJTU_CONSTEXPR20 void assign_n(ForwardIt first, size_t k) {
+    if (k > cap_) {
+      vector tmp(get_alloc());
+      tmp.init_from(first, k);
+      swap_storage(tmp);
+      return;
     }
-    bool operator==(const const_iterator &rhs) const {
-      return owner == rhs.owner && idx == rhs.idx;
+    using source = typename std::remove_cv<
+        typename std::remove_pointer<ForwardIt>::type>::type;
+    if constexpr (trivially_relocatable && std::is_pointer<ForwardIt>::value &&
+                  std::is_same<source, T>::value) {
+      if (!SJTU_CONSTANT_EVALUATED()) {
+        if (k != 0) std::memmove(data_, first, k * sizeof(T));
+        sz_ = k;
+        return;
+      }
     }
-    bool operator==(const iterator &rhs) const {
-      return owner == rhs.owner && idx == rhs.idx;
+    size_t common = k < sz_ ? k : sz_;
+    for (size_t i = 0; i < common; ++i, ++first) data_[i] = *first;
+    if (k < sz_) {
+      destroy_from(k);
+    } else {
+      for (; sz_ < k; ++sz_, ++first) construct(data_ + sz_, *first);
     }
-    bool operator!=(const const_iterator &rhs) const { return !(*this == rhs); }
-    bool operator!=(const iterator &rhs) const { return !(*this == rhs); }
-  };
+  }
 
-  vector() = default;
-  vector(const vector &other) : data_(nullptr), sz_(0), cap_(0) {
-    if (other.sz_) {
-      data_ = raw_alloc(other.sz_);
-      cap_ = other.sz_;
-      size_t i = 0;
+ public:
+  using iterator = detail::contiguous_iterator<vector, T>;
+  using const_iterator = detail::contiguous_iterator<vector, const T>;
+
+  SJTU_CONSTEXPR20 vector() = default;
+  SJTU_CONSTEXPR20 explicit vector(const Alloc &alloc) noexcept
+      : holder(alloc) {}
+  SJTU_CONSTEXPR20 explicit vector(size_t n, const Alloc &alloc = Alloc())
+      : holder(alloc) {
+    try {
+      reserve(n);
+      grow_to(n);
+    } catch (...) {
+      release();
+      throw;
+    }
+  }
+  SJTU_CONSTEXPR20 vector(size_t n, const T &value,
+                          const Alloc &alloc = Alloc())
+      : holder(alloc) {
+    init_fill(n, value);
+  }
+  // Forward ranges are measured first and copied into one exact buffer.
+  template <typename InputIt, typename = typename std::enable_if<
+                                  !std::is_integral<InputIt>::value>::type>
+  SJTU_CONSTEXPR20 vector(InputIt first, InputIt last,
+                          const Alloc &alloc = Alloc())
+      : holder(alloc) {
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+      init_from(first, static_cast<size_t>(std::distance(first, last)));
+    } else {
       try {
-        for (; i < other.sz_; ++i) new (data_ + i) T(other.data_[i]);
+        for (; first != last; ++first) emplace_back(*first);
       } catch (...) {
-        for (size_t j = 0; j < i; ++j) data_[j].~T();
-        raw_free(data_);
-        data_ = nullptr;
-        cap_ = 0;
+        release();
         throw;
       }
-      sz_ = other.sz_;
     }
   }
-  ~vector() {
-    clear();
-    if (data_) raw_free(data_);
-    data_ = nullptr;
-    cap_ = 0;
+  SJTU_CONSTEXPR20 vector(std::initializer_list<T> il,
+                          const Alloc &alloc = Alloc())
+      : holder(alloc) {
+    init_from(il.begin(), il.size());
+  }
+  SJTU_CONSTEXPR20 vector(const vector &other)
+      : vector(other, alloc_traits::select_on_container_copy_construction(
+                          other.get_alloc())) {}
+  SJTU_CONSTEXPR20 vector(const vector &other, const Alloc &alloc)
+      : holder(alloc) {
+    init_from(other.data_, other.sz_);
   }
-  vector &operator=(const vector &other) {
+  SJTU_CONSTEXPR20 vector(vector &&other) noexcept
+      : holder(std::move(other.get_alloc())) {
+    steal(other);
+  }
+  SJTU_CONSTEXPR20 vector(vector &&other, const Alloc &alloc) : holder(alloc) {
+    if (get_alloc() == other.get_alloc()) {
+      steal(other);
+    } else {
+      init_from(std::make_move_iterator(other.data_), other.sz_);
+    }
+  }
+  SJTU_CONSTEXPR20 ~vector() { release(); }
+
+  // Copies into the existing buffer when it is large enough; see assign_n.
+  SJTU_CONSTEXPR20 vector &operator=(const vector &other) {
     if (this == &other) return *this;
-    vector tmp(other);
-    swap(tmp);
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+      if (get_alloc() != other.get_alloc()) release();
+      get_alloc() = other.get_alloc();
+    }
+    assign_n(other.data_, other.sz_);
+    return *this;
+  }
+  SJTU_CONSTEXPR20 vector &operator=(vector &&other) noexcept(
+      alloc_traits::propagate_on_container_move_assignment::value ||
+      alloc_traits::is_always_equal::value) {
+    if (this == &other) return *this;
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+      release();
+      get_alloc() = std::move(other.get_alloc());
+      steal(other);
+    } else if (get_alloc() == other.get_alloc()) {
+      release();
+      steal(other);
+    } else {
+      vector tmp(std::move(other), get_alloc());
+      swap_storage(tmp);
+    }
     return *this;
   }
 
-  void swap(vector &rhs) {
-    T *td = data_;
-    data_ = rhs.data_;
-    rhs.data_ = td;
-    size_t ts = sz_;
-    sz_ = rhs.sz_;
-    rhs.sz_ = ts;
-    size_t tc = cap_;
-    cap_ = rhs.cap_;
-    rhs.cap_ = tc;
+  // Allocators are exchanged only when they propagate on swap; swapping
+  // two vectors with unequal, non-propagating allocators is undefined, as
+  // for std::vector.
+  SJTU_CONSTEXPR20 void swap(vector &rhs) noexcept {
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      std::swap(get_alloc(), rhs.get_alloc());
+    }
+    swap_storage(rhs);
   }
 
-  T &at(const size_t &pos) {
+  SJTU_CONSTEXPR20 Alloc get_allocator() const { return get_alloc(); }
+
+  SJTU_CONSTEXPR20 T &at(const size_t &pos) {
     if (pos >= sz_) throw index_out_of_bound();
     return data_[pos];
   }
-  const T &at(const size_t &pos) const {
+  SJTU_CONSTEXPR20 const T &at(const size_t &pos) const {
     if (pos >= sz_) throw index_out_of_bound();
     return data_[pos];
   }
 
-  T &operator[](const size_t &pos) {
-    if (pos >= sz_) throw index_out_of_bound();
+  SJTU_CONSTEXPR20 T &operator[](const size_t &pos) {
+    detail::check_subscript(pos, sz_);
     return data_[pos];
   }
-  const T &operator[](const size_t &pos) const {
-    if (pos >= sz_) throw index_out_of_bound();
+  SJTU_CONSTEXPR20 const T &operator[](const size_t &pos) const {
+    detail::check_subscript(pos, sz_);
     return data_[pos];
   }
 
-  const T &front() const {
+  SJTU_CONSTEXPR20 const T &front() const {
     if (sz_ == 0) throw container_is_empty();
     return data_[0];
   }
-  const T &back() const {
+  SJTU_CONSTEXPR20 const T &back() const {
     if (sz_ == 0) throw container_is_empty();
     return data_[sz_ - 1];
   }
 
-  iterator begin() { return iterator(this, 0); }
-  const_iterator begin() const { return const_iterator(this, 0); }
-  const_iterator cbegin() const { return const_iterator(this, 0); }
+  // The underlying buffer; null while nothing has been allocated.
+  SJTU_CONSTEXPR20 T *data() { return data_; }
+  SJTU_CONSTEXPR20 const T *data() const { return data_; }
+
+  SJTU_CONSTEXPR20 iterator begin() { return iterator(data_, this); }
+  SJTU_CONSTEXPR20 const_iterator begin() const {
+    return const_iterator(data_, this);
+  }
+  SJTU_CONSTEXPR20 const_iterator cbegin() const {
+    return const_iterator(data_, this);
+  }
+
+  SJTU_CONSTEXPR20 iterator end() { return iterator(data_ + sz_, this); }
+  SJTU_CONSTEXPR20 const_iterator end() const {
+    return const_iterator(data_ + sz_, this);
+  }
+  SJTU_CONSTEXPR20 const_iterator cend() const {
+    return const_iterator(data_ + sz_, this);
+  }
+
+  SJTU_CONSTEXPR20 bool empty() const { return sz_ == 0; }
+  SJTU_CONSTEXPR20 size_t size() const { return sz_; }
+  SJTU_CONSTEXPR20 size_t capacity() const { return cap_; }
+
+  // Allocates exactly n slots, so a known-size load costs one allocation.
+  SJTU_CONSTEXPR20 void reserve(size_t n) {
+    if (n > cap_) reallocate(n);
+  }
+
+  SJTU_CONSTEXPR20 void shrink_to_fit() {
+    if (sz_ < cap_) reallocate(sz_);
+  }
+
+  SJTU_CONSTEXPR20 void clear() { truncate(0); }
+
+  // Drops every element from n on; a no-op when n >= size().
+  SJTU_CONSTEXPR20 void truncate(size_t n) {
+    destroy_from(n);
+    maybe_shrink();
+  }
+
+  // New elements are value-initialized; shrinking behaves like truncate.
+  SJTU_CONSTEXPR20 void resize(size_t n) {
+    if (n <= sz_) {
+      truncate(n);
+    } else {
+      grow_to(n);
+    }
+  }
+
+  SJTU_CONSTEXPR20 void resize(size_t n, const T &value) {
+    if (n <= sz_) {
+      truncate(n);
+    } else if (n > cap_) {
+      T tmp(value);
+      grow_to(n, tmp);
+    } else {
+      grow_to(n, value);
+    }
+  }
+
+  // Like resize(n), but new elements of a trivial T are left
+  // uninitialized, for buffers the caller overwrites anyway.
+  SJTU_CONSTEXPR20 void resize_default_init(size_t n) {
+    if constexpr (std::is_trivial<T>::value) {
+      if (SJTU_CONSTANT_EVALUATED()) {
+        resize(n);
+      } else if (n <= sz_) {
+        truncate(n);
+      } else {
+        ensure_capacity(n);
+        sz_ = n;
+      }
+    } else {
+      resize(n);
+    }
+  }
 
-  iterator end() { return iterator(this, sz_); }
-  const_iterator end() const { return const_iterator(this, sz_); }
-  const_iterator cend() const { return const_iterator(this, sz_); }
+  SJTU_CONSTEXPR20 void assign(size_t n, const T &value) {
+    T tmp(value);
+    assign_n(repeat_iterator{&tmp}, n);
+  }
 
-  bool empty() const { return sz_ == 0; }
-  size_t size() const { return sz_; }
+  template <typename InputIt, typename = typename std::enable_if<
+                                  !std::is_integral<InputIt>::value>::type>
+  SJTU_CONSTEXPR20 void assign(InputIt first, InputIt last) {
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+      assign_n(first, static_cast<size_t>(std::distance(first, last)));
+    } else {
+      destroy_from(0);
+      for (; first != last; ++first) emplace_back(*first);
+    }
+  }
 
-  void clear() {
-    for (size_t i = 0; i < sz_; ++i) data_[i].~T();
-    sz_ = 0;
+  SJTU_CONSTEXPR20 void assign(std::initializer_list<T> il) {
+    assign_n(il.begin(), il.size());
   }
 
-  iterator insert(iterator pos, const T &value) {
-    if (pos.owner != this) throw invalid_iterator();
-    return insert(pos.idx, value);
+  template <typename... Args>
+  SJTU_CONSTEXPR20 iterator emplace(iterator pos, Args &&...args) {
+    return emplace(index_of(pos), std::forward<Args>(args)...);
   }
 
-  iterator insert(const size_t &ind, const T &value) {
+  // Without a regrowth the slot at ind still holds a live element, so the
+  // value is built aside first; args may then alias elements being shifted.
+  template <typename... Args>
+  SJTU_CONSTEXPR20 iterator emplace(const size_t &ind, Args &&...args) {
     if (ind > sz_) throw index_out_of_bound();
-    ensure_capacity(sz_ + 1);
-    if (ind == sz_) {
-      new (data_ + sz_) T(value);
+    if (sz_ == cap_) {
+      grow_emplace(ind, std::forward<Args>(args)...);
+    } else if (ind == sz_) {
+      construct(data_ + sz_, std::forward<Args>(args)...);
       ++sz_;
-      return iterator(this, ind);
+    } else {
+      T tmp(std::forward<Args>(args)...);
+      shift_in(ind, std::move(tmp));
+    }
+    return iterator(data_ + ind, this);
+  }
+
+  SJTU_CONSTEXPR20 iterator insert(iterator pos, const T &value) {
+    return insert(index_of(pos), value);
+  }
+
+  SJTU_CONSTEXPR20 iterator insert(iterator pos, T &&value) {
+    return insert(index_of(pos), std::move(value));
+  }
+
+  SJTU_CONSTEXPR20 iterator insert(const size_t &ind, const T &value) {
+    return emplace(ind, value);
+  }
+
+  SJTU_CONSTEXPR20 iterator insert(const size_t &ind, T &&value) {
+    if (ind > sz_) throw index_out_of_bound();
+    if (ind == sz_ || sz_ == cap_) return emplace(ind, std::move(value));
+    shift_in(ind, std::move(value));
+    return iterator(data_ + ind, this);
+  }
+
+  SJTU_CONSTEXPR20 iterator insert(iterator pos, size_t n, const T &value) {
+    return insert(index_of(pos), n, value);
+  }
+
+  SJTU_CONSTEXPR20 iterator insert(const size_t &ind, size_t n,
+                                   const T &value) {
+    if (ind > sz_) throw index_out_of_bound();
+    if (n == 0) return iterator(data_ + ind, this);
+    T tmp(value);
+    insert_n(ind, repeat_iterator{&tmp}, n);
+    return iterator(data_ + ind, this);
+  }
+
+  template <typename InputIt, typename = typename std::enable_if<
+                                  !std::is_integral<InputIt>::value>::type>
+  SJTU_CONSTEXPR20 iterator insert(iterator pos, InputIt first, InputIt last) {
+    return insert(index_of(pos), first, last);
+  }
+
+  // Single-pass ranges cannot be measured up front, so they are buffered
+  // first and then moved in with one shift.
+  template <typename InputIt, typename = typename std::enable_if<
+                                  !std::is_integral<InputIt>::value>::type>
+  SJTU_CONSTEXPR20 iterator insert(const size_t &ind, InputIt first,
+                                   InputIt last) {
+    if (ind > sz_) throw index_out_of_bound();
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+      insert_n(ind, first, static_cast<size_t>(std::distance(first, last)));
+    } else {
+      vector buf(get_alloc());
+      for (; first != last; ++first) buf.emplace_back(*first);
+      insert_n(ind, std::make_move_iterator(buf.data_), buf.sz_);
     }
-    new (data_ + sz_) T(data_[sz_ - 1]);
-    for (size_t i = sz_ - 1; i > ind; --i) {
-      data_[i] = data_[i - 1];
+    return iterator(data_ + ind, this);
+  }
+
+  SJTU_CONSTEXPR20 iterator insert(iterator pos, std::initializer_list<T> il) {
+    return insert(pos, il.begin(), il.end());
+  }
+
+  SJTU_CONSTEXPR20 iterator insert(const size_t &ind,
+                                   std::initializer_list<T> il) {
+    return insert(ind, il.begin(), il.end());
+  }
+
+  // p may point into this vector.
+  SJTU_CONSTEXPR20 void append(const T *p, size_t n) {
+    if (sz_ + n > cap_ && p >= data_ && p < data_ + sz_) {
+      size_t off = p - data_;
+      ensure_capacity(sz_ + n);
+      p = data_ + off;
     }
-    data_[ind] = value;
-    ++sz_;
-    return iterator(this, ind);
+    insert_n(sz_, p, n);
+  }
+
+  SJTU_CONSTEXPR20 iterator erase(iterator pos) {
+    if (pos == end()) throw invalid_iterator();
+    return erase(pos, pos + 1);
   }
 
-  iterator erase(iterator pos) {
-    if (pos.owner != this || pos.idx >= sz_) throw invalid_iterator();
-    size_t ind = pos.idx;
-    if (ind == sz_ - 1) {
-      data_[sz_ - 1].~T();
-      --sz_;
-      return end();
+  // Closes the gap with a single shift of the tail. The result is rebuilt
+  // after maybe_shrink, which may have moved the buffer.
+  SJTU_CONSTEXPR20 iterator erase(iterator first, iterator last) {
+    size_t lo = index_of(first), hi = index_of(last);
+    if (lo > hi) throw invalid_iterator();
+    size_t k = hi - lo;
+    if (k == 0) return first;
+    bool moved = false;
+    if constexpr (trivially_relocatable) {
+      if (!SJTU_CONSTANT_EVALUATED()) {
+        std::memmove(data_ + lo, data_ + hi, (sz_ - hi) * sizeof(T));
+        sz_ -= k;
+        moved = true;
+      }
     }
-    for (size_t i = ind; i + 1 < sz_; ++i) {
-      data_[i] = data_[i + 1];
+    if (!moved) {
+      for (size_t i = hi; i < sz_; ++i) data_[i - k] = std::move(data_[i]);
+      destroy_from(sz_ - k);
     }
-    data_[sz_ - 1].~T();
-    --sz_;
-    return iterator(this, ind);
+    maybe_shrink();
+    return iterator(data_ + lo, this);
   }
 
-  iterator erase(const size_t &ind) {
+  SJTU_CONSTEXPR20 iterator erase(const size_t &ind) {
     if (ind >= sz_) throw index_out_of_bound();
-    return erase(iterator(this, ind));
+    return erase(iterator(data_ + ind, this));
   }
 
-  void push_back(const T &value) {
-    ensure_capacity(sz_ + 1);
-    new (data_ + sz_) T(value);
-    ++sz_;
+  template <typename... Args>
+  SJTU_CONSTEXPR20 T &emplace_back(Args &&...args) {
+    if (sz_ == cap_) {
+      grow_emplace(sz_, std::forward<Args>(args)...);
+    } else {
+      construct(data_ + sz_, std::forward<Args>(args)...);
+      ++sz_;
+    }
+    return data_[sz_ - 1];
   }
 
-  void pop_back() {
+  SJTU_CONSTEXPR20 void push_back(const T &value) { emplace_back(value); }
+  SJTU_CONSTEXPR20 void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  SJTU_CONSTEXPR20 void pop_back() {
     if (sz_ == 0) throw container_is_empty();
     --sz_;
-    data_[sz_].~T();
+    destroy(data_ + sz_);
+    maybe_shrink();
+  }
+
+  SJTU_CONSTEXPR20 void pop_back(size_t n) {
+    if (n > sz_) throw container_is_empty();
+    truncate(sz_ - n);
   }
 };
 